@@ -0,0 +1,511 @@
+// End-to-end benchmark for the plugin's dispatch paths.
+//
+// Links ChatSDKModulePlugin against the in-process stub liblogoschat and
+// routes events to an in-process sink, so only plugin code is measured:
+//
+//   event_callback     stub thread(s) -> callback queue -> emitEvent
+//   sendMessage        Q_INVOKABLE call -> FFI -> result event
+//   listConversations  Q_INVOKABLE call -> FFI -> index reset -> result event
+//   getConversation    round trip while sendMessage floods a library that
+//                      serves one call at a time, without and with priority
+//                      lanes
+//
+// For each path it reports throughput, heap allocations per operation and
+// p50/p99/p99.9 latency.
+
+#include "chatsdk_module_plugin.h"
+#include "event_classifier.h"
+#include "latency_histogram.h"
+#include "stub_liblogoschat.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+thread_local bool allocationCountingPaused = false;
+
+void countAllocation()
+{
+    if (!allocationCountingPaused) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Excludes the bench's own bookkeeping from the allocation count
+struct AllocationPause {
+    AllocationPause() : previous(allocationCountingPaused) { allocationCountingPaused = true; }
+    ~AllocationPause() { allocationCountingPaused = previous; }
+    bool previous;
+};
+
+}
+
+#if defined(__GLIBC__)
+// Qt containers allocate with malloc directly, so count at that level
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+// Elsewhere only C++ allocations are visible
+void* operator new(size_t size)
+{
+    countAllocation();
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+namespace {
+
+struct Options {
+    int events = 200000;
+    int payloadBytes = 256;
+    int threads = 1;
+    int rate = 0;
+    int sends = 100000;
+    int lists = 200;
+    int conversations = 1000;
+    int probes = 200;
+    int flood = 50;
+    int serviceUs = 20;
+    int laneWindow = 8;
+    bool asyncCallbacks = true;
+};
+
+struct Result {
+    const char* scenario;
+    uint64_t operations;
+    double seconds;
+    uint64_t allocations;
+    const LatencyHistogram* latency;
+};
+
+template <typename Predicate>
+bool waitFor(Predicate done, int timeoutMs = 30000)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+        if (timer.elapsed() > timeoutMs) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Result events end with the request ID and then the context handle;
+// chatsdkSendMessageResult adds the outbox idempotency key after those
+qint64 requestIdOf(const QString& eventName, const QVariantList& data)
+{
+    const int fromEnd = eventName == QLatin1String("chatsdkSendMessageResult") ? 3 : 2;
+    return data.size() < fromEnd ? 0 : data.at(data.size() - fromEnd).toLongLong();
+}
+
+void printHeader()
+{
+    std::printf("%-18s %10s %12s %10s %10s %10s %10s %10s\n",
+                "scenario", "ops", "ops/sec", "allocs/op", "p50 us", "p99 us", "p99.9 us", "max us");
+}
+
+void printResult(const Result& result)
+{
+    const double ops = static_cast<double>(result.operations);
+    const auto us = [&](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::printf("%-18s %10llu %12.0f %10.2f %10.1f %10.1f %10.1f %10.1f\n",
+                result.scenario,
+                static_cast<unsigned long long>(result.operations),
+                result.seconds > 0 ? ops / result.seconds : 0.0,
+                ops > 0 ? static_cast<double>(result.allocations) / ops : 0.0,
+                us(result.latency->valueAtQuantile(0.50)),
+                us(result.latency->valueAtQuantile(0.99)),
+                us(result.latency->valueAtQuantile(0.999)),
+                us(result.latency->max()));
+}
+
+Options parseOptions(const QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks the chatsdk module dispatch paths against a stub liblogoschat.");
+    parser.addHelpOption();
+
+    const QCommandLineOption events("events", "Push events to fire.", "n", "200000");
+    const QCommandLineOption payload("payload", "Message content size in bytes.", "bytes", "256");
+    const QCommandLineOption threads("threads", "Threads firing push events.", "n", "1");
+    const QCommandLineOption rate("rate", "Total push events per second (0 = unthrottled).", "n", "0");
+    const QCommandLineOption sends("sends", "sendMessage calls to issue.", "n", "100000");
+    const QCommandLineOption lists("lists", "listConversations round trips.", "n", "200");
+    const QCommandLineOption conversations("conversations", "Conversations reported by the stub.", "n", "1000");
+    const QCommandLineOption probes("probes", "getConversation round trips under a send flood.", "n", "200");
+    const QCommandLineOption flood("flood", "sendMessage calls issued before each probe.", "n", "50");
+    const QCommandLineOption service("service-us", "Stub time per operation during the flood, in us.", "us", "20");
+    const QCommandLineOption lanes("lanes", "In-flight window of the priority lanes run.", "n", "8");
+    const QCommandLineOption mode("mode", "Callback delivery: async (worker thread) or sync (inline).", "mode", "async");
+    parser.addOptions({ events, payload, threads, rate, sends, lists, conversations, probes, flood, service, lanes, mode });
+    parser.process(app);
+
+    Options options;
+    options.events = parser.value(events).toInt();
+    options.payloadBytes = parser.value(payload).toInt();
+    options.threads = parser.value(threads).toInt();
+    options.rate = parser.value(rate).toInt();
+    options.sends = parser.value(sends).toInt();
+    options.lists = parser.value(lists).toInt();
+    options.conversations = parser.value(conversations).toInt();
+    options.probes = parser.value(probes).toInt();
+    options.flood = parser.value(flood).toInt();
+    options.serviceUs = parser.value(service).toInt();
+    options.laneWindow = parser.value(lanes).toInt();
+    options.asyncCallbacks = parser.value(mode) != "sync";
+    return options;
+}
+
+}
+
+// ============================================================================
+// Scenarios
+// ============================================================================
+
+namespace {
+
+class Bench
+{
+public:
+    explicit Bench(const Options& options) : options(options)
+    {
+        plugin.setEventSink([this](const QString& eventName, const QVariantList& data) {
+            AllocationPause pause;
+            onEvent(eventName, data);
+        });
+    }
+
+    bool setUp()
+    {
+        const qint64 initId = plugin.initChat("{}");
+        if (!initId || !waitFor([&]() { return lastResultId >= initId; })) {
+            std::fprintf(stderr, "initChat did not complete\n");
+            return false;
+        }
+        plugin.setEventCallback();
+
+        const qint64 startId = plugin.startChat();
+        if (!startId || !waitFor([&]() { return lastResultId >= startId; })) {
+            std::fprintf(stderr, "startChat did not complete\n");
+            return false;
+        }
+        return true;
+    }
+
+    Result runEvents()
+    {
+        {
+            AllocationPause pause;
+            firedAtNs.assign(static_cast<size_t>(options.events), 0);
+        }
+        const quint64 droppedBefore = droppedEvents();
+        eventsReceived = 0;
+
+        const uint64_t allocationsBefore = allocationCount.load();
+        const int64_t start = stubNowNs();
+
+        std::atomic<bool> firing{true};
+        std::thread producer([&]() {
+            stubFireEvents(options.events, options.payloadBytes, options.threads, options.rate, firedAtNs);
+            firing.store(false);
+        });
+
+        // Stop once every event has arrived, or the producers are done and
+        // whatever the queue dropped will never come
+        waitFor([&]() {
+            if (eventsReceived >= options.events) {
+                return true;
+            }
+            if (firing.load()) {
+                return false;
+            }
+            const quint64 dropped = droppedEvents() - droppedBefore;
+            return eventsReceived + static_cast<int>(dropped) >= options.events;
+        });
+
+        const int64_t elapsed = stubNowNs() - start;
+        const uint64_t allocations = allocationCount.load() - allocationsBefore;
+        producer.join();
+
+        const quint64 dropped = droppedEvents() - droppedBefore;
+        if (dropped) {
+            std::fprintf(stderr, "event_callback: %llu events dropped by a full callback queue\n",
+                         static_cast<unsigned long long>(dropped));
+        }
+
+        return { "event_callback", static_cast<uint64_t>(eventsReceived), elapsed / 1e9, allocations, &eventLatency };
+    }
+
+    Result runSends()
+    {
+        const QString convoId = "bench-convo-0";
+        const QString contentHex = QString(options.payloadBytes * 2, QLatin1Char('a'));
+
+        {
+            AllocationPause pause;
+            sendSubmittedAtNs.assign(static_cast<size_t>(options.sends), 0);
+        }
+        firstSendId = 0;
+        sendsCompleted = 0;
+
+        const uint64_t allocationsBefore = allocationCount.load();
+        const int64_t start = stubNowNs();
+
+        for (int i = 0; i < options.sends; ++i) {
+            const int64_t submittedAt = stubNowNs();
+            const qint64 requestId = plugin.sendMessage(convoId, contentHex);
+            if (!firstSendId) {
+                firstSendId = requestId;
+            }
+            sendSubmittedAtNs[static_cast<size_t>(requestId - firstSendId)] = submittedAt;
+
+            // Keep results flowing instead of letting the whole run queue up
+            if ((i & 255) == 255) {
+                QCoreApplication::processEvents(QEventLoop::AllEvents);
+            }
+        }
+        waitFor([&]() { return sendsCompleted >= options.sends; });
+
+        const int64_t elapsed = stubNowNs() - start;
+        const uint64_t allocations = allocationCount.load() - allocationsBefore;
+        return { "sendMessage", static_cast<uint64_t>(sendsCompleted), elapsed / 1e9, allocations, &sendLatency };
+    }
+
+    Result runLists()
+    {
+        const uint64_t allocationsBefore = allocationCount.load();
+        const int64_t start = stubNowNs();
+        int completed = 0;
+
+        for (int i = 0; i < options.lists; ++i) {
+            const int64_t submittedAt = stubNowNs();
+            const qint64 requestId = plugin.listConversations();
+            if (!requestId || !waitFor([&]() { return lastResultId >= requestId; })) {
+                break;
+            }
+            listLatency.record(static_cast<uint64_t>(stubNowNs() - submittedAt));
+            ++completed;
+        }
+
+        const int64_t elapsed = stubNowNs() - start;
+        const uint64_t allocations = allocationCount.load() - allocationsBefore;
+        return { "listConversations", static_cast<uint64_t>(completed), elapsed / 1e9, allocations, &listLatency };
+    }
+
+    // A caller waiting on getConversation while sends pile up in front of it
+    Result runProbes(int laneWindow)
+    {
+        const QString convoId = "bench-convo-0";
+        const QString contentHex = QString(options.payloadBytes * 2, QLatin1Char('a'));
+        LatencyHistogram& latency = laneWindow ? laneProbeLatency : fifoProbeLatency;
+
+        plugin.setPriorityLanes(laneWindow, 8, 4, 1);
+        stubSetServiceTimeUs(options.serviceUs);
+        const int sendResultsBefore = sendResults;
+
+        const uint64_t allocationsBefore = allocationCount.load();
+        const int64_t start = stubNowNs();
+        int completed = 0;
+
+        for (int i = 0; i < options.probes; ++i) {
+            qint64 lastSendId = 0;
+            for (int j = 0; j < options.flood; ++j) {
+                lastSendId = plugin.sendMessage(convoId, contentHex);
+            }
+            // The newest send jumps the flood, as one a user just typed would
+            if (laneWindow) {
+                plugin.setRequestLane(lastSendId, "interactive");
+            }
+
+            const int64_t submittedAt = stubNowNs();
+            const qint64 requestId = plugin.getConversation(convoId);
+            if (!requestId || !waitFor([&]() { return lastResultId >= requestId; })) {
+                break;
+            }
+            latency.record(static_cast<uint64_t>(stubNowNs() - submittedAt));
+            ++completed;
+        }
+
+        const int64_t elapsed = stubNowNs() - start;
+        const uint64_t allocations = allocationCount.load() - allocationsBefore;
+
+        // Let the flood finish before the next run
+        waitFor([&]() { return sendResults - sendResultsBefore >= completed * options.flood; });
+        stubSetServiceTimeUs(0);
+
+        // Every slot taken, including by moved calls, must have been given back
+        const int slotsHeld = laneSlotsInFlight();
+        if (slotsHeld != 0) {
+            std::fprintf(stderr, "priority lanes: %d in-flight slots not released\n", slotsHeld);
+            lanesBalanced = false;
+        }
+        plugin.setPriorityLanes(0, 8, 4, 1);
+
+        return { laneWindow ? "probe/lanes" : "probe/fifo", static_cast<uint64_t>(completed), elapsed / 1e9,
+                 allocations, &latency };
+    }
+
+    bool lanesBalanced = true;
+
+private:
+    int laneSlotsInFlight()
+    {
+        AllocationPause pause;
+        int inFlight = 0;
+        const QVariantMap lanes = plugin.getMetrics().value("lanes").toMap();
+        for (const QVariant& lane : lanes) {
+            inFlight += lane.toMap().value("inFlight").toInt();
+        }
+        return inFlight;
+    }
+
+    quint64 droppedEvents()
+    {
+        AllocationPause pause;
+        return plugin.getEventQueueStats().value("dropped").toULongLong();
+    }
+
+    void onEvent(const QString& eventName, const QVariantList& data)
+    {
+        const int64_t now = stubNowNs();
+
+        if (eventName == "chatsdkNewMessage") {
+            const QByteArray payload = data.value(0).toString().toUtf8();
+            std::string_view seq;
+            if (findJsonStringField(payload.constData(), static_cast<size_t>(payload.size()), "seq", seq)) {
+                const size_t index = std::stoul(std::string(seq));
+                if (index < firedAtNs.size()) {
+                    eventLatency.record(static_cast<uint64_t>(now - firedAtNs[index]));
+                }
+            }
+            ++eventsReceived;
+            return;
+        }
+
+        const qint64 requestId = requestIdOf(eventName, data);
+        if (eventName == "chatsdkSendMessageResult") {
+            ++sendResults;
+        }
+        if (eventName == "chatsdkSendMessageResult" && firstSendId && requestId >= firstSendId) {
+            const size_t index = static_cast<size_t>(requestId - firstSendId);
+            if (index < sendSubmittedAtNs.size()) {
+                sendLatency.record(static_cast<uint64_t>(now - sendSubmittedAtNs[index]));
+                ++sendsCompleted;
+            }
+        }
+        if (requestId > lastResultId) {
+            lastResultId = requestId;
+        }
+    }
+
+    Options options;
+    ChatSDKModulePlugin plugin;
+
+    qint64 lastResultId = 0;
+
+    std::vector<int64_t> firedAtNs;
+    int eventsReceived = 0;
+    LatencyHistogram eventLatency;
+
+    std::vector<int64_t> sendSubmittedAtNs;
+    qint64 firstSendId = 0;
+    int sendsCompleted = 0;
+    LatencyHistogram sendLatency;
+    int sendResults = 0;
+
+    LatencyHistogram listLatency;
+    LatencyHistogram fifoProbeLatency;
+    LatencyHistogram laneProbeLatency;
+};
+
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    const Options options = parseOptions(app);
+
+    // Callback logging is off by default; the per-request qDebug lines on the
+    // call side would still dominate every measurement
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    StubConfig config;
+    config.asyncCallbacks = options.asyncCallbacks;
+    config.conversationCount = options.conversations;
+    stubConfigure(config);
+
+    Bench bench(options);
+    if (!bench.setUp()) {
+        return 1;
+    }
+
+    std::printf("mode=%s payload=%dB threads=%d rate=%d conversations=%d\n",
+                options.asyncCallbacks ? "async" : "sync", options.payloadBytes, options.threads,
+                options.rate, options.conversations);
+    printHeader();
+    printResult(bench.runEvents());
+    printResult(bench.runSends());
+    printResult(bench.runLists());
+    if (options.asyncCallbacks) {
+        printResult(bench.runProbes(0));
+        printResult(bench.runProbes(options.laneWindow));
+    }
+    return bench.lanesBalanced ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// Micro-benchmark for push event classification.
+//
+// Compares classifyChatEvent() against the previous approach of decoding the
+// payload into a QString, re-encoding it and building a QJsonDocument just to
+// read "eventType". Payloads mimic new_message events with hex content of
+// increasing size.
+
+#include "event_classifier.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <cstdio>
+
+namespace {
+
+QByteArray makePayload(int contentBytes, bool eventTypeFirst)
+{
+    const QByteArray content = QByteArray(contentBytes, 'x').toHex();
+    const QByteArray body = "\"conversationId\":\"0xabcdef0123456789\",\"content\":\"" + content + "\"";
+    if (eventTypeFirst) {
+        return "{\"eventType\":\"new_message\"," + body + "}";
+    }
+    return "{" + body + ",\"eventType\":\"new_message\"}";
+}
+
+ChatEventType classifyWithDom(const QByteArray& payload)
+{
+    QString message = QString::fromUtf8(payload);
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    const QString eventType = doc.object()["eventType"].toString();
+    if (eventType == "new_message") {
+        return ChatEventType::NewMessage;
+    } else if (eventType == "new_conversation") {
+        return ChatEventType::NewConversation;
+    } else if (eventType == "delivery_ack") {
+        return ChatEventType::DeliveryAck;
+    }
+    return ChatEventType::Unknown;
+}
+
+template <typename Fn>
+double nsPerCall(const QByteArray& payload, int iterations, Fn fn)
+{
+    int hits = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        hits += fn(payload) == ChatEventType::NewMessage;
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    if (hits != iterations) {
+        std::fprintf(stderr, "misclassified %d of %d payloads\n", iterations - hits, iterations);
+    }
+    return static_cast<double>(elapsed) / iterations;
+}
+
+}
+
+int main()
+{
+    const int sizes[] = { 64, 1024, 16 * 1024, 256 * 1024 };
+
+    std::printf("%-10s %-8s %14s %14s %10s\n", "content", "key", "dom ns/evt", "scan ns/evt", "speedup");
+    for (int size : sizes) {
+        for (bool first : { true, false }) {
+            const QByteArray payload = makePayload(size, first);
+            const int iterations = qMax(50, (8 * 1024 * 1024) / payload.size());
+
+            const double dom = nsPerCall(payload, iterations, classifyWithDom);
+            const double scan = nsPerCall(payload, iterations, [](const QByteArray& p) {
+                return classifyChatEvent(p.constData(), static_cast<size_t>(p.size()));
+            });
+
+            std::printf("%-10d %-8s %14.0f %14.0f %9.1fx\n", size, first ? "first" : "last", dom, scan, dom / scan);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Micro-benchmark for payload compression.
+//
+// Measures what PayloadCompressor saves on the wire against the CPU it costs
+// on both ends, with and without the primed dictionary, for the payloads the
+// plugin emits most: new_message events with hex content of typical chat
+// sizes, and conversation listings. qCompress at its default level is shown
+// for reference.
+
+#include "payload_compressor.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <cstdio>
+#include <functional>
+
+namespace {
+
+const char kText[] =
+    "Are we still on for tomorrow? I moved the review to ten so that the "
+    "others can join, and I will bring the notes from last week's meeting. ";
+
+QByteArray makeMessage(int contentBytes, int seq)
+{
+    QByteArray text;
+    while (text.size() < contentBytes) {
+        text += kText;
+    }
+    text.truncate(contentBytes);
+
+    return "{\"eventType\":\"new_message\",\"conversationId\":\"0x5f3a9c0e17b2d4c8\","
+           "\"messageId\":\"0x" + QByteArray::number(0x9e3779b97f4a7c15ULL * (seq + 1), 16) + "\","
+           "\"sender\":\"0x2d7e6a41b9c03f58\",\"timestamp\":" + QByteArray::number(1760000000000LL + seq) + ","
+           "\"content\":\"" + text.toHex() + "\"}";
+}
+
+QByteArray makeConversationList(int count)
+{
+    QByteArray list = "[";
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            list += ",";
+        }
+        list += "{\"id\":\"0x" + QByteArray::number(0x51ed2701ULL * (i + 7), 16) + "\",\"type\":\"private\","
+                "\"name\":\"contact " + QByteArray::number(i) + "\",\"lastMessageAt\":"
+                + QByteArray::number(1760000000000LL + i * 977) + "}";
+    }
+    return list + "]";
+}
+
+struct Result {
+    qint64 bytesOut = 0;
+    double compressNs = 0;
+    double decompressNs = 0;
+};
+
+double nsPerCall(int iterations, const std::function<void()>& fn)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return static_cast<double>(timer.nsecsElapsed()) / iterations;
+}
+
+Result measureCompressor(PayloadCompressor& compressor, const QByteArray& payload, bool primed, int iterations)
+{
+    Result result;
+    QByteArray out;
+    if (!compressor.compress(payload.constData(), payload.size(), primed, out)) {
+        result.bytesOut = payload.size();   // sent uncompressed
+        return result;
+    }
+    result.bytesOut = out.size();
+
+    QByteArray back;
+    if (!PayloadCompressor::decompress(out, back) || back != payload) {
+        std::fprintf(stderr, "round trip failed for a %lld byte payload\n", static_cast<long long>(payload.size()));
+    }
+
+    result.compressNs = nsPerCall(iterations, [&]() {
+        compressor.compress(payload.constData(), payload.size(), primed, out);
+    });
+    result.decompressNs = nsPerCall(iterations, [&]() {
+        PayloadCompressor::decompress(out, back);
+    });
+    return result;
+}
+
+Result measureQCompress(const QByteArray& payload, int iterations)
+{
+    Result result;
+    QByteArray out = qCompress(payload);
+    result.bytesOut = qMin<qint64>(out.size(), payload.size());
+    result.compressNs = nsPerCall(iterations, [&]() { out = qCompress(payload); });
+    result.decompressNs = nsPerCall(iterations, [&]() { qUncompress(out); });
+    return result;
+}
+
+void report(const char* label, const QByteArray& payload)
+{
+    const int iterations = qMax(200, (16 * 1024 * 1024) / static_cast<int>(payload.size()));
+    PayloadCompressor compressor;
+
+    const Result plain = measureCompressor(compressor, payload, false, iterations);
+    const Result primed = measureCompressor(compressor, payload, true, iterations);
+    const Result reference = measureQCompress(payload, iterations);
+
+    auto row = [&](const char* mode, const Result& r) {
+        const double saved = payload.size() - r.bytesOut;
+        std::printf("%-14s %-10s %9lld %9lld %6.1f%% %12.0f %12.0f %10.1f\n",
+                    label, mode, static_cast<long long>(payload.size()), static_cast<long long>(r.bytesOut),
+                    100.0 * saved / payload.size(), r.compressNs, r.decompressNs,
+                    r.compressNs > 0 ? saved / (r.compressNs / 1e3) : 0.0);
+    };
+    row("plain", plain);
+    row("primed", primed);
+    row("qCompress", reference);
+}
+
+}
+
+int main()
+{
+    std::printf("%-14s %-10s %9s %9s %7s %12s %12s %10s\n",
+                "payload", "mode", "bytes", "on wire", "saved", "comp ns", "decomp ns", "saved B/us");
+
+    const int contentSizes[] = { 16, 64, 256, 1024, 4096, 16 * 1024, 64 * 1024 };
+    for (int size : contentSizes) {
+        char label[32];
+        std::snprintf(label, sizeof(label), "message %d", size);
+        report(label, makeMessage(size, size));
+    }
+
+    const int conversationCounts[] = { 1, 10, 100, 1000 };
+    for (int count : conversationCounts) {
+        char label[32];
+        std::snprintf(label, sizeof(label), "convos %d", count);
+        report(label, makeConversationList(count));
+    }
+    return 0;
+}
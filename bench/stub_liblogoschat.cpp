@@ -0,0 +1,312 @@
+// In-process stand-in for liblogoschat, used by chatsdk_module_bench.
+//
+// Implements the liblogoschat.h C ABI with no networking so the plugin's
+// dispatch paths can be measured in isolation.
+
+#include "stub_liblogoschat.h"
+#include "liblogoschat.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Callback = void (*)(int, const char*, size_t, void*);
+
+struct StubContext {
+    Callback eventCallback = nullptr;
+    void* eventUserData = nullptr;
+};
+
+// Single worker thread that runs callbacks for asyncCallbacks mode
+class CallbackWorker
+{
+public:
+    ~CallbackWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void post(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!thread.joinable()) {
+                thread = std::thread([this]() { run(); });
+            }
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            std::function<void()> job = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> jobs;
+    std::thread thread;
+    bool stopping = false;
+};
+
+StubConfig config;
+std::atomic<int> serviceTimeUs{0};
+std::string conversationList;
+CallbackWorker worker;
+
+const char kSendResult[] = "{\"messageId\":\"bench-message\"}";
+const char kConversation[] = "{\"id\":\"bench-convo\",\"type\":\"private\"}";
+const char kIdentity[] = "{\"name\":\"bench\"}";
+const char kIntroBundle[] = "bench-intro-bundle";
+
+void buildConversationList()
+{
+    conversationList = "[";
+    for (int i = 0; i < config.conversationCount; ++i) {
+        if (i > 0) {
+            conversationList += ",";
+        }
+        conversationList += "{\"id\":\"bench-convo-" + std::to_string(i) + "\",\"type\":\"private\"}";
+    }
+    conversationList += "]";
+}
+
+// Completes an operation inline or on the worker thread, depending on config
+void complete(Callback callback, void* userData, const char* msg, size_t len)
+{
+    if (!callback) {
+        return;
+    }
+    if (config.asyncCallbacks) {
+        worker.post([callback, userData, msg, len]() {
+            const int us = serviceTimeUs.load(std::memory_order_relaxed);
+            if (us > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(us));
+            }
+            callback(RET_OK, msg, len, userData);
+        });
+    } else {
+        callback(RET_OK, msg, len, userData);
+    }
+}
+
+void completeEmpty(Callback callback, void* userData)
+{
+    complete(callback, userData, nullptr, 0);
+}
+
+StubContext* contextFrom(void* ctx)
+{
+    return static_cast<StubContext*>(ctx);
+}
+
+}
+
+void stubConfigure(const StubConfig& newConfig)
+{
+    config = newConfig;
+    buildConversationList();
+}
+
+void stubSetServiceTimeUs(int us)
+{
+    serviceTimeUs.store(us, std::memory_order_relaxed);
+}
+
+int64_t stubNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Fires events through the most recently created context
+static StubContext* activeContext = nullptr;
+
+void stubFireEvents(int count, int payloadBytes, int threads, int ratePerSec, std::vector<int64_t>& firedAtNs)
+{
+    if (!activeContext || !activeContext->eventCallback || count <= 0) {
+        std::fprintf(stderr, "stub: no event callback registered\n");
+        return;
+    }
+
+    firedAtNs.assign(count, 0);
+    threads = threads > 0 ? threads : 1;
+
+    const std::string prefix = "{\"eventType\":\"new_message\",\"conversationId\":\"bench-convo-0\",\"seq\":\"";
+    const std::string seqDigits(10, '0');
+    const std::string contentHex(static_cast<size_t>(payloadBytes) * 2, 'a');
+    const std::string templ = prefix + seqDigits + "\",\"content\":\"" + contentHex + "\"}";
+    const size_t seqOffset = prefix.size();
+
+    Callback callback = activeContext->eventCallback;
+    void* userData = activeContext->eventUserData;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t]() {
+            std::string buffer = templ;
+            const int64_t start = stubNowNs();
+            const double intervalNs = ratePerSec > 0 ? 1e9 * threads / ratePerSec : 0.0;
+            int fired = 0;
+
+            for (int seq = t; seq < count; seq += threads, ++fired) {
+                if (intervalNs > 0) {
+                    const int64_t due = start + static_cast<int64_t>(fired * intervalNs);
+                    while (stubNowNs() < due) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                // Overwrite the fixed-width seq field in place; no allocation per event
+                int value = seq;
+                for (size_t i = 0; i < seqDigits.size(); ++i) {
+                    buffer[seqOffset + seqDigits.size() - 1 - i] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                }
+
+                firedAtNs[seq] = stubNowNs();
+                callback(RET_OK, buffer.data(), buffer.size(), userData);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+}
+
+// ============================================================================
+// liblogoschat.h C ABI
+// ============================================================================
+
+extern "C" {
+
+void* chat_new(const char* configJson, Callback callback, void* userData)
+{
+    (void)configJson;
+    if (conversationList.empty()) {
+        buildConversationList();
+    }
+
+    activeContext = new StubContext;
+    completeEmpty(callback, userData);
+    return activeContext;
+}
+
+int chat_start(void* ctx, Callback callback, void* userData)
+{
+    (void)ctx;
+    completeEmpty(callback, userData);
+    return RET_OK;
+}
+
+int chat_stop(void* ctx, Callback callback, void* userData)
+{
+    (void)ctx;
+    completeEmpty(callback, userData);
+    return RET_OK;
+}
+
+int chat_destroy(void* ctx, Callback callback, void* userData)
+{
+    StubContext* context = contextFrom(ctx);
+    if (context == activeContext) {
+        activeContext = nullptr;
+    }
+    delete context;
+    completeEmpty(callback, userData);
+    return RET_OK;
+}
+
+void set_event_callback(void* ctx, Callback callback, void* userData)
+{
+    StubContext* context = contextFrom(ctx);
+    context->eventCallback = callback;
+    context->eventUserData = userData;
+}
+
+int chat_get_id(void* ctx, Callback callback, void* userData)
+{
+    (void)ctx;
+    static const char id[] = "bench-client";
+    complete(callback, userData, id, sizeof(id) - 1);
+    return RET_OK;
+}
+
+int chat_list_conversations(void* ctx, Callback callback, void* userData)
+{
+    (void)ctx;
+    complete(callback, userData, conversationList.data(), conversationList.size());
+    return RET_OK;
+}
+
+int chat_get_conversation(void* ctx, Callback callback, void* userData, const char* convoId)
+{
+    (void)ctx;
+    (void)convoId;
+    complete(callback, userData, kConversation, sizeof(kConversation) - 1);
+    return RET_OK;
+}
+
+int chat_new_private_conversation(void* ctx, Callback callback, void* userData, const char* introBundle, const char* contentHex)
+{
+    (void)ctx;
+    (void)introBundle;
+    (void)contentHex;
+    complete(callback, userData, kConversation, sizeof(kConversation) - 1);
+    return RET_OK;
+}
+
+int chat_send_message(void* ctx, Callback callback, void* userData, const char* convoId, const char* contentHex)
+{
+    (void)ctx;
+    (void)convoId;
+    (void)contentHex;
+    complete(callback, userData, kSendResult, sizeof(kSendResult) - 1);
+    return RET_OK;
+}
+
+int chat_get_identity(void* ctx, Callback callback, void* userData)
+{
+    (void)ctx;
+    complete(callback, userData, kIdentity, sizeof(kIdentity) - 1);
+    return RET_OK;
+}
+
+int chat_create_intro_bundle(void* ctx, Callback callback, void* userData)
+{
+    (void)ctx;
+    complete(callback, userData, kIntroBundle, sizeof(kIntroBundle) - 1);
+    return RET_OK;
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Control surface of the stub liblogoschat used by chatsdk_module_bench.
+//
+// The stub implements the liblogoschat.h C ABI without any networking:
+// operations complete immediately, either inline on the calling thread or
+// from a worker thread, and push events are generated on demand.
+
+struct StubConfig {
+    // Deliver operation callbacks from a worker thread instead of inline,
+    // like the real library does.
+    bool asyncCallbacks = true;
+    // Number of conversations reported by chat_list_conversations.
+    int conversationCount = 1000;
+};
+
+void stubConfigure(const StubConfig& config);
+
+/**
+ * Makes the worker spend @p us microseconds on every operation before its
+ * callback, like a library that processes calls one at a time. Only applies
+ * to asyncCallbacks mode; may be changed while operations are in flight.
+ */
+void stubSetServiceTimeUs(int us);
+
+/**
+ * Fires @p count new_message push events carrying @p payloadBytes of content
+ * through the registered event callback, spread over @p threads threads and
+ * throttled to @p ratePerSec in total (0 = as fast as possible). Blocks until
+ * every event has been handed to the callback.
+ *
+ * Each payload carries a zero-padded "seq" string field; the monotonic time
+ * each event was fired is stored in @p firedAtNs[seq].
+ */
+void stubFireEvents(int count, int payloadBytes, int threads, int ratePerSec, std::vector<int64_t>& firedAtNs);
+
+/** Steady-clock time in nanoseconds, shared by the stub and the bench. */
+int64_t stubNowNs();
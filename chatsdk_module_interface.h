@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QtCore/QObject>
+#include <QtCore/QStringList>
 #include "interface.h"
 
 class ChatSDKModuleInterface : public PluginInterface
@@ -9,23 +10,90 @@ public:
     virtual ~ChatSDKModuleInterface() {}
     
     // Client Lifecycle
-    Q_INVOKABLE virtual bool initChat(const QString &configJson) = 0;
-    Q_INVOKABLE virtual bool startChat() = 0;
-    Q_INVOKABLE virtual bool stopChat() = 0;
-    Q_INVOKABLE virtual bool destroyChat() = 0;
+    Q_INVOKABLE virtual qint64 initChat(const QString &configJson) = 0;
+    Q_INVOKABLE virtual qint64 startChat() = 0;
+    Q_INVOKABLE virtual qint64 stopChat() = 0;
+    Q_INVOKABLE virtual qint64 destroyChat() = 0;
+    Q_INVOKABLE virtual qint64 bootChat(const QString &configJson) = 0;
     Q_INVOKABLE virtual bool setEventCallback() = 0;
+    Q_INVOKABLE virtual bool setEventBatching(bool enabled, int maxBatchSize, int maxLingerMs) = 0;
+    Q_INVOKABLE virtual bool setStructuredDelivery(const QString &eventName, bool enabled) = 0;
+    Q_INVOKABLE virtual bool setIsoTimestamps(bool enabled) = 0;
+    Q_INVOKABLE virtual bool setSharedMemoryThreshold(int thresholdBytes) = 0;
+    Q_INVOKABLE virtual bool releaseSharedPayload(qint64 slot) = 0;
+    Q_INVOKABLE virtual bool setPayloadCompression(int thresholdBytes, bool primedDictionary) = 0;
+    Q_INVOKABLE virtual QByteArray getCompressionDictionary() const = 0;
+    Q_INVOKABLE virtual bool subscribe(const QString &eventName) = 0;
+    Q_INVOKABLE virtual bool unsubscribe(const QString &eventName) = 0;
+    Q_INVOKABLE virtual bool setConversationFilter(const QStringList &convoIds) = 0;
     
     // Client Info
-    Q_INVOKABLE virtual bool getId() = 0;
+    Q_INVOKABLE virtual qint64 getId() = 0;
     // Conversation Operations
-    Q_INVOKABLE virtual bool listConversations() = 0;
-    Q_INVOKABLE virtual bool getConversation(const QString &convoId) = 0;
-    Q_INVOKABLE virtual bool newPrivateConversation(const QString &introBundleStr, const QString &contentHex) = 0;
-    Q_INVOKABLE virtual bool sendMessage(const QString &convoId, const QString &contentHex) = 0;
+    Q_INVOKABLE virtual qint64 listConversations() = 0;
+    Q_INVOKABLE virtual qint64 getConversation(const QString &convoId) = 0;
+    Q_INVOKABLE virtual qint64 refreshConversations() = 0;
+    Q_INVOKABLE virtual QVariantList listConversationsSync() const = 0;
+    Q_INVOKABLE virtual QVariantMap getConversationSync(const QString &convoId) const = 0;
+    Q_INVOKABLE virtual QVariantMap listConversationsPage(const QString &cursor, int limit) const = 0;
+    Q_INVOKABLE virtual QVariantMap listConversationsSince(qint64 version) const = 0;
+    Q_INVOKABLE virtual qint64 streamConversations(int chunkSize) = 0;
+    Q_INVOKABLE virtual qint64 newPrivateConversation(const QString &introBundleStr, const QString &contentHex) = 0;
+    Q_INVOKABLE virtual qint64 newPrivateConversationBytes(const QString &introBundleStr, const QByteArray &content) = 0;
+    Q_INVOKABLE virtual qint64 sendMessage(const QString &convoId, const QString &contentHex) = 0;
+    Q_INVOKABLE virtual qint64 sendMessageBytes(const QString &convoId, const QByteArray &content) = 0;
+    Q_INVOKABLE virtual qint64 sendMessages(const QVariantList &messages) = 0;
+    Q_INVOKABLE virtual qint64 broadcastMessage(const QStringList &convoIds, const QByteArray &content) = 0;
     
     // Identity Operations
-    Q_INVOKABLE virtual bool getIdentity() = 0;
-    Q_INVOKABLE virtual bool createIntroBundle() = 0;
+    Q_INVOKABLE virtual qint64 getIdentity() = 0;
+    Q_INVOKABLE virtual qint64 createIntroBundle() = 0;
+    Q_INVOKABLE virtual bool setIntroBundlePoolSize(int size) = 0;
+    Q_INVOKABLE virtual QVariantMap takeIntroBundle() = 0;
+
+    // Diagnostics
+    Q_INVOKABLE virtual QVariantMap getEventQueueStats() const = 0;
+    Q_INVOKABLE virtual QVariantMap getMetrics() = 0;
+    Q_INVOKABLE virtual bool setMetricsInterval(int intervalMs) = 0;
+    Q_INVOKABLE virtual bool setDeliveryTimeout(int timeoutMs) = 0;
+    Q_INVOKABLE virtual QVariantMap getPendingDeliveries() const = 0;
+    Q_INVOKABLE virtual bool setOutbox(const QString &path) = 0;
+    Q_INVOKABLE virtual QVariantMap getOutbox() const = 0;
+
+    // Priority Lanes
+    Q_INVOKABLE virtual bool setPriorityLanes(int maxInFlight, int controlWeight, int interactiveWeight, int bulkWeight) = 0;
+    Q_INVOKABLE virtual bool setOperationLane(const QString &operation, const QString &lane) = 0;
+    Q_INVOKABLE virtual bool setRequestLane(qint64 requestId, const QString &lane) = 0;
+
+    // Multiple Chat Contexts
+    Q_INVOKABLE virtual qint64 createChatContext(const QString &configJson) = 0;
+    Q_INVOKABLE virtual QVariantList listChatContexts() const = 0;
+    Q_INVOKABLE virtual bool setContextShards(int shards) = 0;
+    Q_INVOKABLE virtual qint64 startChatInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual qint64 stopChatInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual qint64 destroyChatInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual bool setEventCallbackInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual qint64 getIdInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual qint64 listConversationsInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual qint64 getConversationInContext(qint64 contextHandle, const QString &convoId) = 0;
+    Q_INVOKABLE virtual qint64 refreshConversationsInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual QVariantList listConversationsSyncInContext(qint64 contextHandle) const = 0;
+    Q_INVOKABLE virtual QVariantMap getConversationSyncInContext(qint64 contextHandle, const QString &convoId) const = 0;
+    Q_INVOKABLE virtual QVariantMap listConversationsPageInContext(qint64 contextHandle, const QString &cursor, int limit) const = 0;
+    Q_INVOKABLE virtual QVariantMap listConversationsSinceInContext(qint64 contextHandle, qint64 version) const = 0;
+    Q_INVOKABLE virtual QVariantMap getPendingDeliveriesInContext(qint64 contextHandle) const = 0;
+    Q_INVOKABLE virtual bool setOutboxInContext(qint64 contextHandle, const QString &path) = 0;
+    Q_INVOKABLE virtual QVariantMap getOutboxInContext(qint64 contextHandle) const = 0;
+    Q_INVOKABLE virtual qint64 streamConversationsInContext(qint64 contextHandle, int chunkSize) = 0;
+    Q_INVOKABLE virtual qint64 newPrivateConversationInContext(qint64 contextHandle, const QString &introBundleStr, const QString &contentHex) = 0;
+    Q_INVOKABLE virtual qint64 newPrivateConversationBytesInContext(qint64 contextHandle, const QString &introBundleStr, const QByteArray &content) = 0;
+    Q_INVOKABLE virtual qint64 sendMessageInContext(qint64 contextHandle, const QString &convoId, const QString &contentHex) = 0;
+    Q_INVOKABLE virtual qint64 sendMessageBytesInContext(qint64 contextHandle, const QString &convoId, const QByteArray &content) = 0;
+    Q_INVOKABLE virtual qint64 sendMessagesInContext(qint64 contextHandle, const QVariantList &messages) = 0;
+    Q_INVOKABLE virtual qint64 broadcastMessageInContext(qint64 contextHandle, const QStringList &convoIds, const QByteArray &content) = 0;
+    Q_INVOKABLE virtual qint64 getIdentityInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual qint64 createIntroBundleInContext(qint64 contextHandle) = 0;
+    Q_INVOKABLE virtual QVariantMap takeIntroBundleInContext(qint64 contextHandle) = 0;
 
 signals:
     void eventResponse(const QString& eventName, const QVariantList& data);
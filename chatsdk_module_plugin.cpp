@@ -1,26 +1,304 @@
 #include "chatsdk_module_plugin.h"
+#include "event_classifier.h"
 #include <QDebug>
 #include <QCoreApplication>
 #include <QVariantList>
 #include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QJsonParseError>
+#include <QLoggingCategory>
+#include <QSet>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
 
-ChatSDKModulePlugin::ChatSDKModulePlugin() : chatCtx(nullptr)
+// One line per SDK callback; off unless enabled, e.g. with
+// QT_LOGGING_RULES="chatsdk.callbacks.debug=true"
+Q_LOGGING_CATEGORY(lcCallbacks, "chatsdk.callbacks", QtWarningMsg)
+
+namespace {
+
+// Sized for bursts of push events while the Qt thread is busy emitting.
+// Each callback shard gets a queue of this size.
+constexpr size_t kCallbackQueueCapacity = 8192;
+
+// Upper bound for setContextShards().
+constexpr int kMaxCallbackShards = 64;
+
+// Callbacks taken from one shard before moving on to the next, so a context
+// flooding its shard cannot hold back results for the others.
+constexpr int kShardDrainBudget = 64;
+
+// Status reported for requests that never reached liblogoschat, e.g. when
+// chat_new fails to create a context, which returns no code.
+constexpr int kNoContextError = -1;
+
+// How long the destructor waits for liblogoschat to finish calling back into
+// the plugin before it leaks the memory those callbacks could still touch.
+constexpr int kTeardownTimeoutMs = 2000;
+
+// How often contexts whose destroy has been confirmed are checked for their
+// last callbacks, so they can be freed without blocking the event loop.
+constexpr int kReapIntervalMs = 10;
+
+// Outbox sends in flight at once while draining, so a long backlog is
+// pipelined without flooding liblogoschat.
+constexpr int kOutboxWindow = 64;
+
+// Outbox appends and completions within this window share one disk flush.
+constexpr int kOutboxSyncMs = 20;
+
+qint64 monotonicNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Polls @p done until it returns true or @p deadlineNs (steady clock) passes.
+template <typename Predicate>
+bool waitUntil(Predicate done, qint64 deadlineNs)
+{
+    while (!done()) {
+        if (monotonicNowNs() >= deadlineNs) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+// Decodes the hex "content" field of a new_message payload.
+QByteArray extractMessageContent(const QByteArray& payload)
+{
+    std::string_view contentHex;
+    if (findJsonStringField(payload.constData(), static_cast<size_t>(payload.size()), "content", contentHex)) {
+        return QByteArray::fromHex(QByteArray::fromRawData(contentHex.data(), static_cast<int>(contentHex.size())));
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(payload);
+    return QByteArray::fromHex(doc.object().value("content").toString().toLatin1());
+}
+
+// Reads the conversation a push event refers to.
+QString extractConversationId(const QByteArray& payload)
+{
+    const size_t len = static_cast<size_t>(payload.size());
+    std::string_view convoId;
+    if (findJsonStringField(payload.constData(), len, "conversationId", convoId)
+        || findJsonStringField(payload.constData(), len, "convoId", convoId)) {
+        return QString::fromUtf8(convoId.data(), static_cast<int>(convoId.size()));
+    }
+
+    // A message's own "id" is not its conversation, so only look inside the
+    // nested conversation object here
+    const QVariantMap event = QJsonDocument::fromJson(payload).toVariant().toMap();
+    return ConversationIndex::conversationId(event.value("conversation").toMap());
+}
+
+// Reads the message ID from a send result or delivery ack.
+QString extractMessageId(const QByteArray& payload)
+{
+    std::string_view messageId;
+    if (findJsonStringField(payload.constData(), static_cast<size_t>(payload.size()), "messageId", messageId)) {
+        return QString::fromUtf8(messageId.data(), static_cast<int>(messageId.size()));
+    }
+
+    const QVariantMap object = QJsonDocument::fromJson(payload).toVariant().toMap();
+    return object.value("messageId", object.value("id")).toString();
+}
+
+// Locates the conversation array of a list-conversations result, which is
+// either the document itself or its "conversations" field. Returns the
+// offset just past the '[', or -1 if there is none.
+qint64 conversationArrayStart(const QByteArray& payload)
+{
+    const std::string_view text(payload.constData(), static_cast<size_t>(payload.size()));
+    size_t pos = text.find_first_not_of(" \t\r\n");
+    if (pos == std::string_view::npos) {
+        return -1;
+    }
+    if (text[pos] == '{') {
+        pos = text.find("\"conversations\"", pos);
+        if (pos == std::string_view::npos) {
+            return -1;
+        }
+        pos = text.find_first_not_of(" \t\r\n:", pos + 15);
+    }
+    if (pos == std::string_view::npos || text[pos] != '[') {
+        return -1;
+    }
+    return static_cast<qint64>(pos + 1);
+}
+
+}
+
+/**
+ * Shared state for one @ref ChatSDKModulePlugin::sendMessages or
+ * @ref ChatSDKModulePlugin::broadcastMessage call; the request's kind tells
+ * them apart.
+ *
+ * Each entry is passed to liblogoschat as its own @c userData. Completions
+ * are delivered on the plugin thread, and the one that completes the last
+ * outstanding entry emits the aggregated result and frees the batch.
+ */
+struct ChatSDKModulePlugin::SendBatch
+{
+    struct Item {
+        SendBatch* batch = nullptr;
+        int index = 0;
+        QByteArray convoIdUtf8;
+        QByteArray contentUtf8;      // null for broadcasts, which use sharedContent
+        bool success = false;
+        int code = RET_OK;
+        QString result;
+        qint64 latencyNs = 0;        // from submission of the batch to this entry's callback
+        int lane = -1;               // lane whose in-flight slot the entry holds; -1 if none
+
+        const char* content() const
+        {
+            return contentUtf8.isNull() ? batch->sharedContent.constData() : contentUtf8.constData();
+        }
+    };
+
+    ChatSDKModulePlugin* plugin = nullptr;
+    RequestContext* request = nullptr;
+    QByteArray sharedContent;        // broadcast payload, hex-encoded once for every entry
+    std::vector<Item> items;
+    int remaining = 0;
+
+    bool isBroadcast() const { return request->kind == CallbackKind::BroadcastItem; }
+
+    void complete(Item& item, int callerRet, const QString& result, qint64 completedAtNs, const QVariant& timestamp)
+    {
+        item.success = (callerRet == RET_OK);
+        item.code = callerRet;
+        item.result = result;
+        item.latencyNs = completedAtNs - request->submittedAtNs;
+
+        if (--remaining != 0) {
+            return;
+        }
+
+        const ChatSDKEvent event = isBroadcast() ? ChatSDKEvent::BroadcastMessageResult
+                                                 : ChatSDKEvent::SendMessagesResult;
+        if (plugin->subscriptions.wants(event)) {
+            emitResult(event, timestamp);
+        }
+        plugin->requestPool.release(request);
+        delete this;
+    }
+
+    void emitResult(ChatSDKEvent event, const QVariant& timestamp) const
+    {
+        const bool broadcast = isBroadcast();
+        bool allSucceeded = true;
+        int succeeded = 0;
+        qint64 elapsedNs = 0;
+        QVariantList statuses;
+        statuses.reserve(static_cast<int>(items.size()));
+        for (const Item& entry : items) {
+            allSucceeded = allSucceeded && entry.success;
+            succeeded += entry.success ? 1 : 0;
+            elapsedNs = std::max(elapsedNs, entry.latencyNs);
+
+            QVariantMap status;
+            if (broadcast) {
+                status["convoId"] = QString::fromUtf8(entry.convoIdUtf8);
+            } else {
+                status["index"] = entry.index;
+            }
+            status["success"] = entry.success;
+            status["code"] = entry.code;
+            status["result"] = entry.result;
+            if (broadcast) {
+                status["latencyUs"] = entry.latencyNs / 1000;
+            }
+            statuses << status;
+        }
+
+        QVariantList eventData;
+        eventData << allSucceeded;                       // every entry succeeded
+        eventData << static_cast<int>(items.size());     // batch size
+        if (broadcast) {
+            eventData << succeeded;                      // entries sent successfully
+        }
+        eventData << statuses;                           // per-entry status
+        if (broadcast) {
+            eventData << elapsedNs / 1000;               // until the last entry completed, in us
+        }
+        eventData << timestamp;
+        eventData << request->requestId;
+        eventData << request->contextHandle;
+
+        plugin->emitEvent(event, eventData);
+    }
+};
+
+ChatSDKModulePlugin::ChatSDKModulePlugin()
 {
     qDebug() << "ChatSDKModulePlugin: Initializing...";
+
+    callbackShards.emplace_back(new BoundedMpscQueue<PendingCallback>(kCallbackQueueCapacity));
+
+    eventBatchTimer.setSingleShot(true);
+    eventBatchTimer.setTimerType(Qt::PreciseTimer);
+    eventBatchTimer.setInterval(2);
+    connect(&eventBatchTimer, &QTimer::timeout, this, &ChatSDKModulePlugin::flushEventBatch);
+
+    metricsSnapshotNs = monotonicNowNs();
+    connect(&metricsTimer, &QTimer::timeout, this, &ChatSDKModulePlugin::emitMetrics);
+
+    connect(&deliveryTimer, &QTimer::timeout, this, &ChatSDKModulePlugin::checkDeliveryTimeouts);
+
+    outboxSyncTimer.setSingleShot(true);
+    outboxSyncTimer.setInterval(kOutboxSyncMs);
+    connect(&outboxSyncTimer, &QTimer::timeout, this, &ChatSDKModulePlugin::syncOutboxes);
+
+    reapTimer.setSingleShot(true);
+    reapTimer.setInterval(kReapIntervalMs);
+    connect(&reapTimer, &QTimer::timeout, this, &ChatSDKModulePlugin::reapContexts);
+
+    for (size_t i = 0; i < operationLanes.size(); ++i) {
+        operationLanes[i] = defaultLane(static_cast<CallbackKind>(i));
+    }
+
     qDebug() << "ChatSDKModulePlugin: Initialized successfully";
 }
 
 ChatSDKModulePlugin::~ChatSDKModulePlugin() 
 {
-    // Clean up Chat context if it exists
-    if (chatCtx) {
-        chat_destroy(chatCtx, destroy_callback, this);
-        chatCtx = nullptr;
+    // Contexts may be leaked below; their queued messages must be on disk first
+    syncOutboxes();
+
+    // Clean up remaining Chat contexts. Their destroy callbacks are tracked
+    // like any other request so teardown can wait for them.
+    for (ChatContext* chat : std::as_const(chatContexts)) {
+        chat->state.store(LifecycleState::Destroyed, std::memory_order_release);
+        rejectHeldCalls(chat);
+        RequestContext* request = beginRequest(CallbackKind::Destroy, chat);
+        if (chat_destroy(chat->ctx, destroy_callback, request) != RET_OK) {
+            cancelRequest(request);
+        }
+        retiredContexts.insert(chat->handle, chat);
+    }
+    chatContexts.clear();
+
+    if (detachContexts()) {
+        qDeleteAll(retiredContexts);
+    } else {
+        // Late callbacks may still read their contexts and requests, so
+        // leak those rather than free memory another thread is using
+        qWarning() << "ChatSDKModulePlugin: Chat callbacks still outstanding after" << kTeardownTimeoutMs
+                   << "ms; leaking" << retiredContexts.size() << "chat contexts";
+        requestPool.abandon();
     }
+    retiredContexts.clear();
     
     // Clean up resources
+    eventClient = nullptr;
     if (logosAPI) {
         delete logosAPI;
         logosAPI = nullptr;
@@ -28,6 +306,7 @@ ChatSDKModulePlugin::~ChatSDKModulePlugin()
 }
 
 void ChatSDKModulePlugin::initLogos(LogosAPI* logosAPIInstance) {
+    eventClient = nullptr;
     if (logosAPI) {
         delete logosAPI;
     }
@@ -35,551 +314,2989 @@ void ChatSDKModulePlugin::initLogos(LogosAPI* logosAPIInstance) {
 }
 
 void ChatSDKModulePlugin::emitEvent(const QString& eventName, const QVariantList& data) {
-    if (!logosAPI) {
-        qWarning() << "ChatSDKModulePlugin: LogosAPI not available, cannot emit" << eventName;
+    if (eventSink) {
+        eventSink(eventName, data);
         return;
     }
 
-    LogosAPIClient* client = logosAPI->getClient("chatsdk_module");
-    if (!client) {
-        qWarning() << "ChatSDKModulePlugin: Failed to get chatsdk_module client for event" << eventName;
-        return;
+    // Resolved once and reused until initLogos replaces the LogosAPI
+    if (!eventClient) {
+        if (!logosAPI) {
+            qWarning() << "ChatSDKModulePlugin: LogosAPI not available, cannot emit" << eventName;
+            return;
+        }
+
+        eventClient = logosAPI->getClient("chatsdk_module");
+        if (!eventClient) {
+            qWarning() << "ChatSDKModulePlugin: Failed to get chatsdk_module client for event" << eventName;
+            return;
+        }
     }
 
-    client->onEventResponse(this, eventName, data);
+    eventClient->onEventResponse(this, eventName, data);
 }
 
-// ============================================================================
-// Static Callback Functions
-// ============================================================================
+void ChatSDKModulePlugin::emitEvent(ChatSDKEvent event, const QVariantList& data)
+{
+    emitEvent(chatSDKEventName(event), data);
+}
 
-void ChatSDKModulePlugin::init_callback(int callerRet, const char* msg, size_t len, void* userData)
+QVariant ChatSDKModulePlugin::eventTimestamp(qint64 monotonicNs, qint64 wallClockMs) const
 {
-    qDebug() << "ChatSDKModulePlugin::init_callback called with ret:" << callerRet;
-    
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::init_callback: Invalid userData";
-        return;
+    if (isoTimestamps) {
+        return QDateTime::fromMSecsSinceEpoch(wallClockMs).toString(Qt::ISODate);
     }
-
-    QString message = (msg && len > 0) ? QString::fromUtf8(msg, len) : "";
-
-    QVariantList eventData;
-    eventData << (callerRet == RET_OK);  // success boolean
-    eventData << callerRet;               // return code
-    eventData << message;                 // message (may be empty)
-    eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
-
-    plugin->emitEvent("chatsdkInitResult", eventData);
+    return monotonicNs;
 }
 
-void ChatSDKModulePlugin::start_callback(int callerRet, const char* msg, size_t len, void* userData)
+QVariant ChatSDKModulePlugin::currentTimestamp() const
 {
-    qDebug() << "ChatSDKModulePlugin::start_callback called with ret:" << callerRet;
-    
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::start_callback: Invalid userData";
-        return;
+    if (isoTimestamps) {
+        return QDateTime::currentDateTime().toString(Qt::ISODate);
     }
+    return monotonicNowNs();
+}
 
-    QString message = (msg && len > 0) ? QString::fromUtf8(msg, len) : "";
-    
-    QVariantList eventData;
-    eventData << (callerRet == RET_OK);  // success boolean
-    eventData << callerRet;               // return code
-    eventData << message;
-    eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
-
-    plugin->emitEvent("chatsdkStartResult", eventData);
+void ChatSDKModulePlugin::setEventSink(EventSink sink)
+{
+    eventSink = std::move(sink);
 }
 
-void ChatSDKModulePlugin::stop_callback(int callerRet, const char* msg, size_t len, void* userData)
+QVariantMap ChatSDKModulePlugin::getEventQueueStats() const
 {
-    qDebug() << "ChatSDKModulePlugin::stop_callback called with ret:" << callerRet;
-    
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::stop_callback: Invalid userData";
-        return;
+    size_t capacity = 0;
+    size_t depth = 0;
+    for (const auto& shard : callbackShards) {
+        capacity += shard->capacity();
+        depth += shard->depth();
     }
 
-    QString message = (msg && len > 0) ? QString::fromUtf8(msg, len) : "";
+    QVariantMap stats;
+    stats["capacity"] = static_cast<qulonglong>(capacity);
+    stats["depth"] = static_cast<qulonglong>(depth);
+    stats["shards"] = static_cast<int>(callbackShards.size());
+    stats["enqueued"] = static_cast<qulonglong>(enqueuedCallbacks.load(std::memory_order_relaxed));
+    stats["dropped"] = static_cast<qulonglong>(droppedEvents.load(std::memory_order_relaxed));
+    stats["overflowed"] = static_cast<qulonglong>(overflowedCallbacks.load(std::memory_order_relaxed));
+    return stats;
+}
 
-    QVariantList eventData;
-    eventData << (callerRet == RET_OK);  // success boolean
-    eventData << callerRet;               // return code
-    eventData << message;
-    eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+// ============================================================================
+// Chat Contexts
+// ============================================================================
 
-    plugin->emitEvent("chatsdkStopResult", eventData);
+ChatSDKModulePlugin::ChatContext* ChatSDKModulePlugin::findContext(qint64 contextHandle) const
+{
+    ChatContext* chat = chatContexts.value(contextHandle, nullptr);
+    return chat && chat->acceptsRequests() ? chat : nullptr;
 }
 
-void ChatSDKModulePlugin::destroy_callback(int callerRet, const char* msg, size_t len, void* userData)
+qint64 ChatSDKModulePlugin::createContext(const QString &configJson, qint64 &requestId)
 {
-    qDebug() << "ChatSDKModulePlugin::destroy_callback called with ret:" << callerRet;
-    
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::destroy_callback: Invalid userData";
-        return;
-    }
+    // Convert QString to UTF-8 byte array
+    QByteArray cfgUtf8 = configJson.toUtf8();
 
-    if (msg && len > 0) {
-        QString message = QString::fromUtf8(msg, len);
-        qDebug() << "ChatSDKModulePlugin::destroy_callback message:" << message;
+    // Contexts are spread over the callback shards round-robin
+    ChatContext* chat = new ChatContext;
+    chat->plugin = this;
+    chat->handle = ++lastContextHandle;
+    chat->shard = static_cast<int>((chat->handle - 1) % static_cast<qint64>(callbackShards.size()));
+    for (int lane = 0; lane < LaneScheduler::kLaneCount; ++lane) {
+        chat->lanes.setWeight(lane, laneWeights[static_cast<size_t>(lane)]);
+    }
 
-        QVariantList eventData;
-        eventData << message;
-        eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+    RequestContext* request = beginRequest(CallbackKind::Init, chat);
+    requestId = request->requestId;
 
-        plugin->emitEvent("chatsdkDestroyResult", eventData);
+    // Call chat_new with the configuration
+    chat->ctx = chat_new(cfgUtf8.constData(), init_callback, request);
+    recordSubmission(CallbackKind::Init, chat->ctx ? RET_OK : kNoContextError);
+
+    if (chat->ctx) {
+        qDebug() << "ChatSDKModulePlugin: Chat context" << chat->handle << "created successfully";
+        chat->state.store(LifecycleState::Initialized, std::memory_order_release);
+        chatContexts.insert(chat->handle, chat);
+        return chat->handle;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to create Chat context";
+        cancelRequest(request);
+        delete chat;
+        return 0;
     }
 }
 
-void ChatSDKModulePlugin::event_callback(int callerRet, const char* msg, size_t len, void* userData)
+void ChatSDKModulePlugin::reapContexts()
 {
-    qDebug() << "ChatSDKModulePlugin::event_callback called with ret:" << callerRet;
+    // The destroy callback that confirmed a context may still be returning on
+    // the library thread, and requests sent before the destroy may still be owed
+    bool waiting = false;
+    for (auto it = retiredContexts.begin(); it != retiredContexts.end();) {
+        ChatContext* chat = it.value();
+        if (chat->destroyConfirmed && chat->idle()) {
+            delete chat;
+            it = retiredContexts.erase(it);
+            continue;
+        }
+        waiting = waiting || chat->destroyConfirmed;
+        ++it;
+    }
 
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::event_callback: Invalid userData";
-        return;
+    if (waiting && !reapTimer.isActive()) {
+        reapTimer.start();
     }
+}
 
-    if (msg && len > 0) {
-        QString message = QString::fromUtf8(msg, len);
-        
-        // Parse the JSON to determine the event type
-        QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-        QString eventName = "chatsdkEvent"; // Default event name
-        
-        if (doc.isObject()) {
-            QJsonObject obj = doc.object();
-            QString eventType = obj["eventType"].toString();
-            
-            // Map event types to Qt event names
-            if (eventType == "new_message") {
-                eventName = "chatsdkNewMessage";
-            } else if (eventType == "new_conversation") {
-                eventName = "chatsdkNewConversation";
-            } else if (eventType == "delivery_ack") {
-                eventName = "chatsdkDeliveryAck";
+bool ChatSDKModulePlugin::detachContexts()
+{
+    const qint64 deadlineNs = monotonicNowNs() + kTeardownTimeoutMs * 1000000LL;
+
+    const bool drained = waitUntil([this]() {
+        for (const ChatContext* chat : std::as_const(retiredContexts)) {
+            if (!chat->idle()) {
+                return false;
             }
         }
+        return true;
+    }, deadlineNs);
 
-        QVariantList eventData;
-        eventData << message;
-        eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
-
-        plugin->emitEvent(eventName, eventData);
+    // From here on callbacks return without touching the plugin. Wait for the
+    // ones that got past the check before the flag was set.
+    for (ChatContext* chat : std::as_const(retiredContexts)) {
+        chat->detached.store(true);
     }
+    const bool quiesced = waitUntil([this]() {
+        for (const ChatContext* chat : std::as_const(retiredContexts)) {
+            if (chat->activeCallbacks.load() != 0) {
+                return false;
+            }
+        }
+        return true;
+    }, deadlineNs);
+
+    return drained && quiesced;
 }
 
-void ChatSDKModulePlugin::get_id_callback(int callerRet, const char* msg, size_t len, void* userData)
+const char* ChatSDKModulePlugin::lifecycleStateName(LifecycleState state)
 {
-    qDebug() << "ChatSDKModulePlugin::get_id_callback called with ret:" << callerRet;
-
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::get_id_callback: Invalid userData";
-        return;
+    switch (state) {
+    case LifecycleState::Uninit:      return "uninit";
+    case LifecycleState::Initialized: return "initialized";
+    case LifecycleState::Running:     return "running";
+    case LifecycleState::Stopping:    return "stopping";
+    case LifecycleState::Destroyed:   return "destroyed";
     }
+    return "unknown";
+}
 
-    if (msg && len > 0) {
-        QString message = QString::fromUtf8(msg, len);
-        
-        QVariantList eventData;
-        eventData << message;
-        eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+qint64 ChatSDKModulePlugin::createChatContext(const QString &configJson)
+{
+    qDebug() << "ChatSDKModulePlugin::createChatContext called with config:" << configJson;
 
-        plugin->emitEvent("chatsdkGetIdResult", eventData);
+    qint64 requestId = 0;
+    return createContext(configJson, requestId);
+}
+
+QVariantList ChatSDKModulePlugin::listChatContexts() const
+{
+    QList<qint64> handles = chatContexts.keys();
+    std::sort(handles.begin(), handles.end());
+
+    QVariantList result;
+    result.reserve(handles.size());
+    for (qint64 handle : handles) {
+        const ChatContext* chat = chatContexts.value(handle);
+        QVariantMap entry;
+        entry["handle"] = handle;
+        entry["shard"] = chat->shard;
+        entry["default"] = handle == defaultContextHandle;
+        entry["state"] = QString::fromLatin1(lifecycleStateName(chat->state.load()));
+        entry["pendingCallbacks"] = chat->pendingCallbacks.load();
+        entry["conversations"] = chat->conversationIndex.size();
+        entry["introBundles"] = chat->introBundles.size();
+        entry["heldCalls"] = chat->lanes.queued();
+        result << entry;
     }
+    return result;
 }
 
-void ChatSDKModulePlugin::list_conversations_callback(int callerRet, const char* msg, size_t len, void* userData)
+bool ChatSDKModulePlugin::setContextShards(int shards)
 {
-    qDebug() << "ChatSDKModulePlugin::list_conversations_callback called with ret:" << callerRet;
+    qDebug() << "ChatSDKModulePlugin::setContextShards called with" << shards << "shards";
 
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::list_conversations_callback: Invalid userData";
-        return;
+    if (shards < 1 || shards > kMaxCallbackShards) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set context shards - count must be between 1 and" << kMaxCallbackShards;
+        return false;
     }
 
-    if (msg && len > 0) {
-        QString message = QString::fromUtf8(msg, len);
-        
-        QVariantList eventData;
-        eventData << message;
-        eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+    // Library threads hold on to the queues of live contexts
+    if (!chatContexts.isEmpty() || !retiredContexts.isEmpty()) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set context shards - chat contexts exist";
+        return false;
+    }
 
-        plugin->emitEvent("chatsdkListConversationsResult", eventData);
+    drainCallbacks();
+    callbackShards.clear();
+    for (int i = 0; i < shards; ++i) {
+        callbackShards.emplace_back(new BoundedMpscQueue<PendingCallback>(kCallbackQueueCapacity));
     }
+    return true;
 }
 
-void ChatSDKModulePlugin::get_conversation_callback(int callerRet, const char* msg, size_t len, void* userData)
+// ============================================================================
+// Request Tracking
+// ============================================================================
+
+ChatSDKModulePlugin::RequestContext* ChatSDKModulePlugin::beginRequest(CallbackKind kind, ChatContext* chat, qint64 requestId)
 {
-    qDebug() << "ChatSDKModulePlugin::get_conversation_callback called with ret:" << callerRet;
+    // Counted until the callback has been handed off, see dispatch_callback()
+    chat->pendingCallbacks.fetch_add(1);
+
+    RequestContext* request = requestPool.acquire();
+    request->plugin = this;
+    request->chat = chat;
+    request->requestId = requestId ? requestId : ++lastRequestId;
+    request->contextHandle = chat->handle;
+    request->shard = chat->shard;
+    request->kind = kind;
+    request->submittedAtNs = monotonicNowNs();
+    return request;
+}
 
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::get_conversation_callback: Invalid userData";
-        return;
-    }
+void ChatSDKModulePlugin::cancelRequest(RequestContext* request)
+{
+    // Only for requests the SDK rejected synchronously; no callback will follow
+    request->chat->pendingCallbacks.fetch_sub(1);
+    requestPool.release(request);
+}
 
-    if (msg && len > 0) {
-        QString message = QString::fromUtf8(msg, len);
-        
-        QVariantList eventData;
-        eventData << message;
-        eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+// ============================================================================
+// Priority Lanes
+// ============================================================================
 
-        plugin->emitEvent("chatsdkGetConversationResult", eventData);
+int ChatSDKModulePlugin::defaultLane(CallbackKind kind)
+{
+    switch (kind) {
+    case CallbackKind::Init:
+    case CallbackKind::Start:
+    case CallbackKind::Stop:
+    case CallbackKind::Destroy:
+    case CallbackKind::Event:
+        return LaneScheduler::Control;
+    case CallbackKind::GetId:
+    case CallbackKind::ListConversations:
+    case CallbackKind::GetConversation:
+    case CallbackKind::NewPrivateConversation:
+    case CallbackKind::GetIdentity:
+    case CallbackKind::CreateIntroBundle:
+        return LaneScheduler::Interactive;
+    case CallbackKind::RefreshConversations:
+    case CallbackKind::StreamConversations:
+    case CallbackKind::SendMessage:
+    case CallbackKind::SendBatchItem:
+    case CallbackKind::BroadcastItem:
+    case CallbackKind::RefillIntroBundle:
+    case CallbackKind::SeedConversations:
+        return LaneScheduler::Bulk;
     }
+    return LaneScheduler::Interactive;
 }
 
-void ChatSDKModulePlugin::new_private_conversation_callback(int callerRet, const char* msg, size_t len, void* userData)
+template <typename Submit>
+int ChatSDKModulePlugin::submitRequest(RequestContext* request, Submit submit)
 {
-    qDebug() << "ChatSDKModulePlugin::new_private_conversation_callback called with ret:" << callerRet;
+    return submitRequest(request, operationLanes[static_cast<size_t>(request->kind)], std::move(submit),
+                         [this, request](int result) { rejectRequest(request, result); });
+}
 
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::new_private_conversation_callback: Invalid userData";
-        return;
+template <typename Submit, typename Reject>
+int ChatSDKModulePlugin::submitRequest(RequestContext* request, int lane, Submit submit, Reject reject)
+{
+    // Latency is measured from the SDK call; time spent held is reported per
+    // lane. The slot is freed in the lane the call went out in, which
+    // setRequestLane() may have changed since it was scheduled.
+    auto issue = [this, request, submit](int issuedLane) {
+        request->submittedAtNs = monotonicNowNs();
+        const int result = submit();
+        recordSubmission(request->kind, result);
+        if (result == RET_OK) {
+            request->lane = issuedLane;
+        }
+        return result;
+    };
+
+    return scheduleCall(request->chat, lane, request->requestId, std::move(issue), std::move(reject));
+}
+
+template <typename Submit, typename Reject>
+int ChatSDKModulePlugin::scheduleCall(ChatContext* chat, int lane, qint64 requestId, Submit submit, Reject reject)
+{
+    LaneMetrics& metrics = laneMetrics[static_cast<size_t>(lane)];
+
+    // Issued straight away unless the window is full or others are waiting
+    if (chat->lanes.admits(laneWindow)) {
+        metrics.wait.record(0);
+        const int result = submit(lane);
+        if (result == RET_OK) {
+            chat->lanes.started(lane);
+        }
+        return result;
     }
 
-    QString conversationJson = (msg && len > 0) ? QString::fromUtf8(msg, len) : "";
-    
-    QVariantList eventData;
-    eventData << (callerRet == RET_OK && !conversationJson.isEmpty());  // success
-    eventData << callerRet;                                               // return code
-    eventData << conversationJson;                                        // conversation JSON
-    eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+    LaneScheduler::Call call;
+    call.requestId = requestId;
+    call.queuedAtNs = monotonicNowNs();
+    call.submit = std::move(submit);
+    call.reject = std::move(reject);
+    chat->lanes.push(lane, std::move(call));
 
-    plugin->emitEvent("chatsdkNewPrivateConversationResult", eventData);
+    ++metrics.delayed;
+    metrics.maxHeld = std::max(metrics.maxHeld, chat->lanes.depth(lane));
+    return RET_OK;
 }
 
-void ChatSDKModulePlugin::send_message_callback(int callerRet, const char* msg, size_t len, void* userData)
+void ChatSDKModulePlugin::pumpLanes(ChatContext* chat)
 {
-    qDebug() << "ChatSDKModulePlugin::send_message_callback called with ret:" << callerRet;
-
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::send_message_callback: Invalid userData";
-        return;
+    LaneScheduler::Call call;
+    int lane = 0;
+    while (chat->lanes.hasSlot(laneWindow) && chat->lanes.pop(call, lane)) {
+        const qint64 waitNs = monotonicNowNs() - call.queuedAtNs;
+        laneMetrics[static_cast<size_t>(lane)].wait.record(static_cast<uint64_t>(waitNs));
+
+        const int result = call.submit(lane);
+        if (result == RET_OK) {
+            chat->lanes.started(lane);
+        } else {
+            qWarning() << "ChatSDKModulePlugin: Held" << LaneScheduler::laneName(lane) << "call failed, error code:" << result;
+            call.reject(result);
+        }
     }
+}
 
-    QString resultJson = (msg && len > 0) ? QString::fromUtf8(msg, len) : "";
-    qDebug() << "ChatSDKModulePlugin::send_message_callback result:" << resultJson;
-    
-    QVariantList eventData;
-    eventData << (callerRet == RET_OK);  // success
-    eventData << callerRet;               // return code
-    eventData << resultJson;              // result JSON (may contain message ID)
-    eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+void ChatSDKModulePlugin::rejectRequest(RequestContext* request, int result)
+{
+    // The caller already has the request ID, so the failure is reported as
+    // the call's result. Delivered from the event loop, as a callback would be.
+    request->chat->pendingCallbacks.fetch_sub(1);
+
+    PendingCallback pending;
+    pending.kind = request->kind;
+    pending.callerRet = result;
+    pending.context = request;
+    pending.contextHandle = request->contextHandle;
+    pending.receivedAtNs = monotonicNowNs();
+    pending.receivedAtMs = QDateTime::currentMSecsSinceEpoch();
+    QMetaObject::invokeMethod(this, [this, pending]() mutable { deliverCallback(pending); }, Qt::QueuedConnection);
+}
 
-    plugin->emitEvent("chatsdkSendMessageResult", eventData);
+void ChatSDKModulePlugin::rejectHeldCalls(ChatContext* chat)
+{
+    std::vector<LaneScheduler::Call> held = chat->lanes.takeAll();
+    if (!held.empty()) {
+        qDebug() << "ChatSDKModulePlugin: Failing" << held.size() << "held calls of context" << chat->handle;
+    }
+    for (LaneScheduler::Call& call : held) {
+        call.reject(kNoContextError);
+    }
 }
 
-void ChatSDKModulePlugin::get_identity_callback(int callerRet, const char* msg, size_t len, void* userData)
+bool ChatSDKModulePlugin::setPriorityLanes(int maxInFlight, int controlWeight, int interactiveWeight, int bulkWeight)
 {
-    qDebug() << "ChatSDKModulePlugin::get_identity_callback called with ret:" << callerRet;
+    qDebug() << "ChatSDKModulePlugin::setPriorityLanes called with maxInFlight:" << maxInFlight << "weights:"
+             << controlWeight << interactiveWeight << bulkWeight;
 
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::get_identity_callback: Invalid userData";
-        return;
+    const std::array<int, LaneScheduler::kLaneCount> weights{{controlWeight, interactiveWeight, bulkWeight}};
+    if (maxInFlight < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set priority lanes - maxInFlight is negative";
+        return false;
+    }
+    for (int weight : weights) {
+        if (weight < 1 || weight > LaneScheduler::kMaxWeight) {
+            qWarning() << "ChatSDKModulePlugin: Cannot set priority lanes - weights must be between 1 and" << LaneScheduler::kMaxWeight;
+            return false;
+        }
     }
 
-    if (msg && len > 0) {
-        QString message = QString::fromUtf8(msg, len);
-        
-        QVariantList eventData;
-        eventData << message;
-        eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+    laneWindow = maxInFlight;
+    laneWeights = weights;
 
-        plugin->emitEvent("chatsdkGetIdentityResult", eventData);
+    // A wider window, or none, lets held calls go out now
+    for (ChatContext* chat : std::as_const(chatContexts)) {
+        for (int lane = 0; lane < LaneScheduler::kLaneCount; ++lane) {
+            chat->lanes.setWeight(lane, laneWeights[static_cast<size_t>(lane)]);
+        }
+        pumpLanes(chat);
     }
+    return true;
 }
 
-void ChatSDKModulePlugin::create_intro_bundle_callback(int callerRet, const char* msg, size_t len, void* userData)
+bool ChatSDKModulePlugin::setOperationLane(const QString &operation, const QString &lane)
 {
-    qDebug() << "ChatSDKModulePlugin::create_intro_bundle_callback called with ret:" << callerRet;
+    qDebug() << "ChatSDKModulePlugin::setOperationLane called with" << operation << "->" << lane;
 
-    ChatSDKModulePlugin* plugin = static_cast<ChatSDKModulePlugin*>(userData);
-    if (!plugin) {
-        qWarning() << "ChatSDKModulePlugin::create_intro_bundle_callback: Invalid userData";
-        return;
+    const int laneIndex = LaneScheduler::laneFromName(lane);
+    if (laneIndex < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set operation lane - unknown lane" << lane;
+        return false;
     }
 
-    QString bundleStr = (msg && len > 0) ? QString::fromUtf8(msg, len) : "";
+    // The byte variants share the metrics and lane of their hex counterparts
+    QString name = operation;
+    if (name.endsWith(QLatin1String("Bytes"))) {
+        name.chop(5);
+    }
 
-    QVariantList eventData;
-    eventData << (callerRet == RET_OK && !bundleStr.isEmpty());  // success
-    eventData << callerRet;                                        // return code
-    eventData << bundleStr;                                        // intro bundle string
-    eventData << QDateTime::currentDateTime().toString(Qt::ISODate);
+    for (size_t i = 0; i < operationLanes.size(); ++i) {
+        const CallbackKind kind = static_cast<CallbackKind>(i);
+        if (kind == CallbackKind::Init || kind == CallbackKind::Destroy || kind == CallbackKind::Event) {
+            continue;
+        }
+        if (name == QLatin1String(operationName(kind))) {
+            operationLanes[i] = laneIndex;
+            return true;
+        }
+    }
+
+    qWarning() << "ChatSDKModulePlugin: Cannot set operation lane - unknown or unscheduled operation" << operation;
+    return false;
+}
+
+bool ChatSDKModulePlugin::setRequestLane(qint64 requestId, const QString &lane)
+{
+    qDebug() << "ChatSDKModulePlugin::setRequestLane called with request" << requestId << "->" << lane;
+
+    const int laneIndex = LaneScheduler::laneFromName(lane);
+    if (laneIndex < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set request lane - unknown lane" << lane;
+        return false;
+    }
 
-    plugin->emitEvent("chatsdkCreateIntroBundleResult", eventData);
+    for (ChatContext* chat : std::as_const(chatContexts)) {
+        if (chat->lanes.move(requestId, laneIndex)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 // ============================================================================
-// Client Lifecycle Methods
+// Metrics
 // ============================================================================
 
-bool ChatSDKModulePlugin::initChat(const QString &configJson)
+const char* ChatSDKModulePlugin::operationName(CallbackKind kind)
 {
-    qDebug() << "ChatSDKModulePlugin::initChat called with config:" << configJson;
-    
-    // Convert QString to UTF-8 byte array
-    QByteArray cfgUtf8 = configJson.toUtf8();
-    
-    // Call chat_new with the configuration
-    chatCtx = chat_new(cfgUtf8.constData(), init_callback, this);
-    
-    if (chatCtx) {
-        qDebug() << "ChatSDKModulePlugin: Chat context created successfully";
-        return true;
-    } else {
-        qWarning() << "ChatSDKModulePlugin: Failed to create Chat context";
-        return false;
+    switch (kind) {
+    case CallbackKind::Init:                   return "initChat";
+    case CallbackKind::Start:                  return "startChat";
+    case CallbackKind::Stop:                   return "stopChat";
+    case CallbackKind::Destroy:                return "destroyChat";
+    case CallbackKind::Event:                  return "event";
+    case CallbackKind::GetId:                  return "getId";
+    case CallbackKind::ListConversations:      return "listConversations";
+    case CallbackKind::RefreshConversations:   return "refreshConversations";
+    case CallbackKind::StreamConversations:    return "streamConversations";
+    case CallbackKind::GetConversation:        return "getConversation";
+    case CallbackKind::NewPrivateConversation: return "newPrivateConversation";
+    case CallbackKind::SendMessage:            return "sendMessage";
+    case CallbackKind::SendBatchItem:          return "sendMessages";
+    case CallbackKind::BroadcastItem:          return "broadcastMessage";
+    case CallbackKind::GetIdentity:            return "getIdentity";
+    case CallbackKind::CreateIntroBundle:      return "createIntroBundle";
+    case CallbackKind::RefillIntroBundle:      return "refillIntroBundle";
+    case CallbackKind::SeedConversations:      return "seedConversations";
     }
+    return "unknown";
 }
 
-bool ChatSDKModulePlugin::startChat()
+void ChatSDKModulePlugin::recordSubmission(CallbackKind kind, int result)
 {
-    qDebug() << "ChatSDKModulePlugin::startChat called";
-    
-    if (!chatCtx) {
-        qWarning() << "ChatSDKModulePlugin: Cannot start Chat - context not initialized. Call initChat first.";
-        return false;
+    OperationMetrics& metrics = operationMetrics[static_cast<size_t>(kind)];
+    metrics.submitted.fetch_add(1, std::memory_order_relaxed);
+    if (result != RET_OK) {
+        metrics.rejected.fetch_add(1, std::memory_order_relaxed);
+        metrics.countError(result);
     }
-    
-    int result = chat_start(chatCtx, start_callback, this);
-    
-    if (result == RET_OK) {
-        qDebug() << "ChatSDKModulePlugin: Chat start initiated successfully";
-        return true;
-    } else {
-        qWarning() << "ChatSDKModulePlugin: Failed to start Chat, error code:" << result;
-        return false;
+}
+
+void ChatSDKModulePlugin::recordCompletion(CallbackKind kind, int callerRet, qint64 latencyNs)
+{
+    OperationMetrics& metrics = operationMetrics[static_cast<size_t>(kind)];
+    metrics.latency.record(latencyNs > 0 ? static_cast<uint64_t>(latencyNs) : 0);
+    if (callerRet != RET_OK) {
+        metrics.countError(callerRet);
     }
 }
 
-bool ChatSDKModulePlugin::stopChat()
+QVariantMap ChatSDKModulePlugin::getMetrics()
 {
-    qDebug() << "ChatSDKModulePlugin::stopChat called";
-    
-    if (!chatCtx) {
-        qWarning() << "ChatSDKModulePlugin: Cannot stop Chat - context not initialized.";
-        return false;
+    const qint64 nowNs = monotonicNowNs();
+    const double intervalSec = static_cast<double>(nowNs - metricsSnapshotNs) / 1e9;
+
+    QVariantMap operations;
+    for (size_t i = 0; i < operationMetrics.size(); ++i) {
+        const CallbackKind kind = static_cast<CallbackKind>(i);
+        const OperationMetrics& metrics = operationMetrics[i];
+        if (kind == CallbackKind::Event || metrics.submitted.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+
+        QVariantMap errors;
+        for (size_t code = 0; code < metrics.errorCodes.size(); ++code) {
+            const quint64 count = metrics.errorCodes[code].load(std::memory_order_relaxed);
+            if (count > 0) {
+                const bool other = code == metrics.errorCodes.size() - 1;
+                errors[other ? QStringLiteral("other") : QString::number(code)] = static_cast<qulonglong>(count);
+            }
+        }
+
+        const LatencyHistogram& latency = metrics.latency;
+        QVariantMap entry;
+        entry["submitted"] = static_cast<qulonglong>(metrics.submitted.load(std::memory_order_relaxed));
+        entry["rejected"] = static_cast<qulonglong>(metrics.rejected.load(std::memory_order_relaxed));
+        entry["completed"] = static_cast<qulonglong>(latency.count());
+        entry["errors"] = errors;
+        entry["meanUs"] = latency.mean() / 1e3;
+        entry["p50Us"] = latency.valueAtQuantile(0.5) / 1e3;
+        entry["p99Us"] = latency.valueAtQuantile(0.99) / 1e3;
+        entry["p999Us"] = latency.valueAtQuantile(0.999) / 1e3;
+        entry["maxUs"] = latency.max() / 1e3;
+        operations[operationName(kind)] = entry;
+    }
+
+    QVariantMap events;
+    for (size_t i = 0; i < inboundEvents.size(); ++i) {
+        const quint64 count = inboundEvents[i].load(std::memory_order_relaxed);
+        QVariantMap entry;
+        entry["count"] = static_cast<qulonglong>(count);
+        entry["perSecond"] = intervalSec > 0 ? (count - inboundEventsSnapshot[i]) / intervalSec : 0.0;
+        events[chatSDKEventName(chatSDKPushEvent(static_cast<ChatEventType>(i)))] = entry;
+        inboundEventsSnapshot[i] = count;
+    }
+    metricsSnapshotNs = nowNs;
+
+    int pendingDeliveries = 0;
+    for (const ChatContext* chat : std::as_const(chatContexts)) {
+        pendingDeliveries += chat->deliveries.pending();
+    }
+
+    QVariantMap delivery;
+    delivery["pending"] = pendingDeliveries;
+    delivery["acknowledged"] = static_cast<qulonglong>(deliveryLatency.count());
+    delivery["timedOut"] = static_cast<qulonglong>(deliveriesTimedOut);
+    delivery["meanUs"] = deliveryLatency.mean() / 1e3;
+    delivery["p50Us"] = deliveryLatency.valueAtQuantile(0.5) / 1e3;
+    delivery["p99Us"] = deliveryLatency.valueAtQuantile(0.99) / 1e3;
+    delivery["p999Us"] = deliveryLatency.valueAtQuantile(0.999) / 1e3;
+    delivery["maxUs"] = deliveryLatency.max() / 1e3;
+
+    int pooledIntroBundles = 0;
+    for (const ChatContext* chat : std::as_const(chatContexts)) {
+        pooledIntroBundles += chat->introBundles.size();
+    }
+
+    int outboxPending = 0;
+    for (const ChatContext* chat : std::as_const(chatContexts)) {
+        outboxPending += chat->outbox ? chat->outbox->pending() : 0;
+    }
+
+    QVariantMap outbox;
+    outbox["queued"] = static_cast<qulonglong>(outboxQueued);
+    outbox["drained"] = static_cast<qulonglong>(outboxDrained);
+    outbox["pending"] = outboxPending;
+
+    QVariantMap lanes;
+    lanes["maxInFlight"] = laneWindow;
+    for (int lane = 0; lane < LaneScheduler::kLaneCount; ++lane) {
+        int held = 0;
+        int inFlight = 0;
+        for (const ChatContext* chat : std::as_const(chatContexts)) {
+            held += chat->lanes.depth(lane);
+            inFlight += chat->lanes.inFlight(lane);
+        }
+
+        const LaneMetrics& metrics = laneMetrics[static_cast<size_t>(lane)];
+        const LatencyHistogram& wait = metrics.wait;
+        QVariantMap entry;
+        entry["weight"] = laneWeights[static_cast<size_t>(lane)];
+        entry["held"] = held;
+        entry["inFlight"] = inFlight;
+        entry["maxHeld"] = metrics.maxHeld;
+        entry["calls"] = static_cast<qulonglong>(wait.count());
+        entry["delayed"] = static_cast<qulonglong>(metrics.delayed);
+        entry["meanUs"] = wait.mean() / 1e3;
+        entry["p50Us"] = wait.valueAtQuantile(0.5) / 1e3;
+        entry["p99Us"] = wait.valueAtQuantile(0.99) / 1e3;
+        entry["p999Us"] = wait.valueAtQuantile(0.999) / 1e3;
+        entry["maxUs"] = wait.max() / 1e3;
+        lanes[LaneScheduler::laneName(lane)] = entry;
+    }
+
+    QVariantMap introBundles;
+    introBundles["poolSize"] = introBundlePoolSize;
+    introBundles["pooled"] = pooledIntroBundles;
+    introBundles["hits"] = static_cast<qulonglong>(introBundleHits);
+    introBundles["misses"] = static_cast<qulonglong>(introBundleMisses);
+    introBundles["refilled"] = static_cast<qulonglong>(introBundlesRefilled);
+    introBundles["refillFailures"] = static_cast<qulonglong>(introBundleRefillFailures);
+
+    QVariantMap result;
+    result["operations"] = operations;
+    result["events"] = events;
+    result["eventQueue"] = getEventQueueStats();
+    result["sharedMemory"] = sharedPayloads.stats();
+    result["compression"] = payloadCompressor.stats();
+    result["delivery"] = delivery;
+    result["outbox"] = outbox;
+    result["lanes"] = lanes;
+    result["introBundles"] = introBundles;
+    result["intervalSec"] = intervalSec;
+    return result;
+}
+
+bool ChatSDKModulePlugin::setMetricsInterval(int intervalMs)
+{
+    qDebug() << "ChatSDKModulePlugin::setMetricsInterval called with" << intervalMs << "ms";
+
+    if (intervalMs < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set metrics interval - interval is negative";
+        return false;
+    }
+
+    if (intervalMs == 0) {
+        metricsTimer.stop();
+    } else {
+        metricsTimer.start(intervalMs);
+    }
+    return true;
+}
+
+void ChatSDKModulePlugin::emitMetrics()
+{
+    if (!subscriptions.wants(ChatSDKEvent::Metrics)) {
+        return;
+    }
+
+    QVariantList eventData;
+    eventData << getMetrics();
+    eventData << currentTimestamp();
+
+    emitEvent(ChatSDKEvent::Metrics, eventData);
+}
+
+// ============================================================================
+// Delivery Tracking
+// ============================================================================
+
+void ChatSDKModulePlugin::trackDelivery(ChatContext* chat, const QByteArray& result, const QString& convoId, qint64 sentAtNs)
+{
+    if (!chat || deliveryTimeoutMs == 0) {
+        return;
+    }
+
+    const QString messageId = extractMessageId(result);
+    if (messageId.isEmpty()) {
+        return;
+    }
+
+    chat->deliveries.track(messageId, convoId, sentAtNs);
+    if (!deliveryTimer.isActive()) {
+        deliveryTimer.start(qBound(10, deliveryTimeoutMs / 4, 1000));
+    }
+}
+
+qint64 ChatSDKModulePlugin::acknowledgeDelivery(ChatContext* chat, const QByteArray& ack, qint64 ackAtNs)
+{
+    if (!chat || chat->deliveries.pending() == 0) {
+        return -1;
+    }
+
+    QString convoId;
+    const qint64 sentAtNs = chat->deliveries.acknowledge(extractMessageId(ack), convoId);
+    if (sentAtNs < 0) {
+        return -1;
+    }
+
+    const qint64 latencyNs = std::max<qint64>(ackAtNs - sentAtNs, 0);
+    deliveryLatency.record(static_cast<uint64_t>(latencyNs));
+    return latencyNs;
+}
+
+void ChatSDKModulePlugin::checkDeliveryTimeouts()
+{
+    const qint64 nowNs = monotonicNowNs();
+    const qint64 deadlineNs = nowNs - deliveryTimeoutMs * 1000000LL;
+    const bool wanted = subscriptions.wants(ChatSDKEvent::DeliveryTimeout);
+
+    bool pending = false;
+    for (ChatContext* chat : std::as_const(chatContexts)) {
+        const std::vector<DeliveryTracker::Expired> expired = chat->deliveries.expire(deadlineNs);
+        deliveriesTimedOut += expired.size();
+        pending = pending || chat->deliveries.pending() > 0;
+
+        if (!wanted) {
+            continue;
+        }
+        for (const DeliveryTracker::Expired& entry : expired) {
+            if (!subscriptions.wantsConversation(entry.convoId)) {
+                continue;
+            }
+
+            QVariantList eventData;
+            eventData << entry.messageId;                           // message ID
+            eventData << entry.convoId;                             // conversation ID
+            eventData << (nowNs - entry.sentAtNs) / 1000000;        // ms since send
+            eventData << currentTimestamp();
+            eventData << chat->handle;
+
+            emitPushEvent(ChatSDKEvent::DeliveryTimeout, eventData);
+        }
+    }
+
+    if (!pending) {
+        deliveryTimer.stop();
+    }
+}
+
+bool ChatSDKModulePlugin::setDeliveryTimeout(int timeoutMs)
+{
+    qDebug() << "ChatSDKModulePlugin::setDeliveryTimeout called with" << timeoutMs << "ms";
+
+    if (timeoutMs < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set delivery timeout - timeout is negative";
+        return false;
+    }
+
+    deliveryTimeoutMs = timeoutMs;
+    if (timeoutMs == 0) {
+        deliveryTimer.stop();
+        for (ChatContext* chat : std::as_const(chatContexts)) {
+            chat->deliveries.clear();
+        }
+    } else if (deliveryTimer.isActive()) {
+        deliveryTimer.setInterval(qBound(10, timeoutMs / 4, 1000));
+    }
+    return true;
+}
+
+QVariantMap ChatSDKModulePlugin::getPendingDeliveries() const
+{
+    return getPendingDeliveriesInContext(defaultContextHandle);
+}
+
+QVariantMap ChatSDKModulePlugin::getPendingDeliveriesInContext(qint64 contextHandle) const
+{
+    const ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        return QVariantMap();
+    }
+
+    QVariantMap result;
+    result["pending"] = chat->deliveries.pending();
+    result["pendingByConversation"] = chat->deliveries.pendingByConversation();
+    return result;
+}
+
+// ============================================================================
+// Outbox
+// ============================================================================
+
+bool ChatSDKModulePlugin::setOutbox(const QString &path)
+{
+    return setOutboxInContext(defaultContextHandle, path);
+}
+
+bool ChatSDKModulePlugin::setOutboxInContext(qint64 contextHandle, const QString &path)
+{
+    qDebug() << "ChatSDKModulePlugin::setOutbox called with path:" << path;
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set outbox - context not initialized";
+        return false;
+    }
+
+    // Completions of in-flight sends could no longer be recorded, so they
+    // would be sent again by the next run
+    if (chat->outbox && chat->outbox->inFlight() > 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set outbox -" << chat->outbox->inFlight() << "queued sends still in flight";
+        return false;
+    }
+
+    chat->outbox.reset();
+    if (path.isEmpty()) {
+        return true;
+    }
+
+    std::unique_ptr<Outbox> outbox(new Outbox(path));
+    if (!outbox->open()) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set outbox - failed to open" << path;
+        return false;
+    }
+    chat->outbox = std::move(outbox);
+
+    drainOutbox(chat);
+    return true;
+}
+
+QVariantMap ChatSDKModulePlugin::getOutbox() const
+{
+    return getOutboxInContext(defaultContextHandle);
+}
+
+QVariantMap ChatSDKModulePlugin::getOutboxInContext(qint64 contextHandle) const
+{
+    const ChatContext* chat = findContext(contextHandle);
+    if (!chat || !chat->outbox) {
+        return QVariantMap();
+    }
+
+    QVariantList entries;
+    entries.reserve(chat->outbox->pending());
+    for (const Outbox::Entry& entry : chat->outbox->entries()) {
+        QVariantMap item;
+        item["key"] = QString::number(entry.key, 16);
+        item["convoId"] = QString::fromUtf8(entry.convoId);
+        item["queuedAt"] = entry.queuedAtMs;
+        item["requestId"] = entry.requestId;
+        item["inFlight"] = entry.inFlight;
+        entries << item;
+    }
+
+    QVariantMap result = chat->outbox->stats();
+    result["path"] = chat->outbox->path();
+    result["entries"] = entries;
+    return result;
+}
+
+qint64 ChatSDKModulePlugin::queueInOutbox(ChatContext* chat, const QString& convoId, const QByteArray& contentHex, qint64 requestId)
+{
+    // Reserved now so the caller can match the result event once it is sent
+    if (!requestId) {
+        requestId = ++lastRequestId;
+    }
+    if (!chat->outbox->append(convoId.toUtf8(), contentHex, QDateTime::currentMSecsSinceEpoch(), requestId)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot send message - outbox is full";
+        return 0;
+    }
+
+    ++outboxQueued;
+    if (!outboxSyncTimer.isActive()) {
+        outboxSyncTimer.start();
+    }
+    qDebug() << "ChatSDKModulePlugin: Message queued in outbox," << chat->outbox->pending() << "pending";
+
+    drainOutbox(chat);
+    return requestId;
+}
+
+void ChatSDKModulePlugin::drainOutbox(ChatContext* chat)
+{
+    if (!chat->outbox || chat->state.load() != LifecycleState::Running) {
+        return;
+    }
+
+    while (chat->outbox->inFlight() < kOutboxWindow) {
+        const Outbox::Entry* entry = chat->outbox->next();
+        if (!entry) {
+            break;
+        }
+
+        // Replayed messages have no reserved ID and take a fresh one
+        RequestContext* request = beginRequest(CallbackKind::SendMessage, chat, entry->requestId);
+        request->convoId = QString::fromUtf8(entry->convoId);
+        request->outboxKey = entry->key;
+
+        // Left queued for the next completion or start to pick up
+        auto requeue = [this, chat, request](int) {
+            if (chat->outbox) {
+                chat->outbox->retry(request->outboxKey);
+            }
+            cancelRequest(request);
+        };
+
+        // Drains are background work, whatever lane sendMessage is in
+        const QByteArray convoId = entry->convoId;
+        const QByteArray contentHex = entry->contentHex;
+        int result = submitRequest(request, LaneScheduler::Bulk, [chat, request, convoId, contentHex]() {
+            return chat_send_message(chat->ctx, send_message_callback, request, convoId.constData(), contentHex.constData());
+        }, requeue);
+
+        if (result != RET_OK) {
+            qWarning() << "ChatSDKModulePlugin: Failed to drain outbox, error code:" << result;
+            requeue(result);
+            break;
+        }
+    }
+}
+
+void ChatSDKModulePlugin::syncOutboxes()
+{
+    for (ChatContext* chat : std::as_const(chatContexts)) {
+        if (chat->outbox) {
+            chat->outbox->sync();
+        }
+    }
+    for (ChatContext* chat : std::as_const(retiredContexts)) {
+        if (chat->outbox) {
+            chat->outbox->sync();
+        }
+    }
+}
+
+// ============================================================================
+// Callback Handoff
+// ============================================================================
+
+void ChatSDKModulePlugin::enqueueCallback(CallbackKind kind, int callerRet, const char* msg, size_t len, void* context)
+{
+    const qint64 nowNs = monotonicNowNs();
+
+    // Each callback goes to the shard of the chat context it belongs to
+    qint64 contextHandle = 0;
+    int shard = 0;
+    if (kind == CallbackKind::Event) {
+        const ChatContext* chat = static_cast<const ChatContext*>(context);
+        contextHandle = chat->handle;
+        shard = chat->shard;
+    } else if (context) {
+        const RequestContext* request = (kind == CallbackKind::SendBatchItem || kind == CallbackKind::BroadcastItem)
+            ? static_cast<SendBatch::Item*>(context)->batch->request
+            : static_cast<RequestContext*>(context);
+        recordCompletion(kind, callerRet, nowNs - request->submittedAtNs);
+        contextHandle = request->contextHandle;
+        shard = request->shard;
+    }
+
+    PendingCallback pending;
+    pending.kind = kind;
+    pending.callerRet = callerRet;
+    pending.context = context;
+    pending.contextHandle = contextHandle;
+    pending.receivedAtNs = nowNs;
+    pending.receivedAtMs = QDateTime::currentMSecsSinceEpoch();
+    if (msg && len > 0) {
+        pending.payload = QByteArray(msg, static_cast<int>(len));
+    }
+
+    if (callbackShards[static_cast<size_t>(shard)]->tryPush(std::move(pending))) {
+        enqueuedCallbacks.fetch_add(1, std::memory_order_relaxed);
+
+        // Only the first producer after a drain posts a wake-up to the Qt thread
+        if (!drainScheduled.exchange(true)) {
+            QMetaObject::invokeMethod(this, [this]() { drainCallbacks(); }, Qt::QueuedConnection);
+        }
+        return;
+    }
+
+    // Push events are best effort; drop them rather than stall the library thread
+    if (kind == CallbackKind::Event) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Results complete a request the caller is waiting on, so they are never
+    // dropped. Fall back to a regular queued call when the ring is full.
+    overflowedCallbacks.fetch_add(1, std::memory_order_relaxed);
+    QMetaObject::invokeMethod(this, [this, pending]() mutable { deliverCallback(pending); }, Qt::QueuedConnection);
+}
+
+void ChatSDKModulePlugin::drainCallbacks()
+{
+    // Clear the flag before popping so a push racing with this drain either
+    // lands in this loop or schedules the next drain.
+    drainScheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Round-robin over the shards with a per-shard budget
+    PendingCallback pending;
+    bool delivered = true;
+    while (delivered) {
+        delivered = false;
+        for (const auto& shard : callbackShards) {
+            for (int n = 0; n < kShardDrainBudget && shard->tryPop(pending); ++n) {
+                deliverCallback(pending);
+                delivered = true;
+            }
+        }
+    }
+}
+
+void ChatSDKModulePlugin::deliverCallback(PendingCallback& pending)
+{
+    const int callerRet = pending.callerRet;
+    const QByteArray& payload = pending.payload;
+    const QVariant timestamp = eventTimestamp(pending.receivedAtNs, pending.receivedAtMs);
+
+    // Every kind except push events and batch entries carries its own request
+    RequestContext* request = nullptr;
+    if (pending.kind != CallbackKind::Event && pending.kind != CallbackKind::SendBatchItem
+        && pending.kind != CallbackKind::BroadcastItem) {
+        request = static_cast<RequestContext*>(pending.context);
+    }
+    const qint64 requestId = request ? request->requestId : 0;
+
+    // Requests made through the async API resolve their future instead of emitting
+    Resolver resolve;
+    if (request && !awaitedRequests.isEmpty()) {
+        resolve = awaitedRequests.take(requestId);
+    }
+    const bool awaited = static_cast<bool>(resolve);
+
+    // Looked up rather than carried so callbacks racing a destroy find nothing
+    const qint64 contextHandle = pending.contextHandle;
+    ChatContext* chat = findContext(contextHandle);
+
+    // The call's in-flight slot is free again; held calls go out once it has been delivered
+    int freedLane = -1;
+    if (request) {
+        freedLane = request->lane;
+    } else if (pending.kind == CallbackKind::SendBatchItem || pending.kind == CallbackKind::BroadcastItem) {
+        freedLane = static_cast<SendBatch::Item*>(pending.context)->lane;
+    }
+    if (chat && freedLane >= 0) {
+        chat->lanes.finished(freedLane);
+    }
+
+    switch (pending.kind) {
+    case CallbackKind::Init: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::init_callback called with ret:" << callerRet;
+
+        if (chat && chat->boot.requestId && chat->boot.initRequestId == requestId) {
+            continueBoot(chat, callerRet, payload, pending.receivedAtNs, timestamp);
+            break;
+        }
+
+        if (!subscriptions.wants(ChatSDKEvent::InitResult)) {
+            break;
+        }
+
+        QVariantList eventData;
+        eventData << (callerRet == RET_OK);  // success boolean
+        eventData << callerRet;               // return code
+        eventData << QString::fromUtf8(payload);  // message (may be empty)
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+
+        emitEvent(ChatSDKEvent::InitResult, eventData);
+        break;
+    }
+    case CallbackKind::Start: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::start_callback called with ret:" << callerRet;
+
+        // Seed the conversation index and bundle pool once the client is up
+        if (callerRet == RET_OK && chat) {
+            seedConversations(chat);
+            refillIntroBundles(chat);
+            drainOutbox(chat);
+        } else if (chat) {
+            chat->advance(LifecycleState::Running, LifecycleState::Initialized);
+        }
+
+        if (chat && chat->boot.requestId && chat->boot.startRequestId == requestId) {
+            // Set when chat_start was actually issued, which a priority lane may have delayed
+            chat->boot.startSubmittedAtNs = request->submittedAtNs;
+            finishBoot(chat, callerRet, payload, pending.receivedAtNs, timestamp);
+            break;
+        }
+
+        if (awaited || !subscriptions.wants(ChatSDKEvent::StartResult)) {
+            break;
+        }
+
+        QVariantList eventData;
+        eventData << (callerRet == RET_OK);  // success boolean
+        eventData << callerRet;               // return code
+        eventData << QString::fromUtf8(payload);
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+
+        emitEvent(ChatSDKEvent::StartResult, eventData);
+        break;
+    }
+    case CallbackKind::Stop: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::stop_callback called with ret:" << callerRet;
+
+        if (chat) {
+            chat->advance(LifecycleState::Stopping,
+                          callerRet == RET_OK ? LifecycleState::Initialized : LifecycleState::Running);
+        }
+
+        if (awaited || !subscriptions.wants(ChatSDKEvent::StopResult)) {
+            break;
+        }
+
+        QVariantList eventData;
+        eventData << (callerRet == RET_OK);  // success boolean
+        eventData << callerRet;               // return code
+        eventData << QString::fromUtf8(payload);
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+
+        emitEvent(ChatSDKEvent::StopResult, eventData);
+        break;
+    }
+    case CallbackKind::Destroy: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::destroy_callback called with ret:" << callerRet;
+
+        // Nothing refers to the context any more once the SDK confirms
+        if (ChatContext* retired = retiredContexts.value(contextHandle, nullptr)) {
+            retired->destroyConfirmed = true;
+            reapContexts();
+        }
+
+        if (!payload.isEmpty() && subscriptions.wants(ChatSDKEvent::DestroyResult)) {
+            QString message = QString::fromUtf8(payload);
+            qCDebug(lcCallbacks) << "ChatSDKModulePlugin::destroy_callback message:" << message;
+
+            QVariantList eventData;
+            eventData << message;
+            eventData << timestamp;
+            eventData << requestId;
+            eventData << contextHandle;
+
+            emitEvent(ChatSDKEvent::DestroyResult, eventData);
+        }
+        break;
+    }
+    case CallbackKind::Event: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::event_callback called with ret:" << callerRet;
+
+        if (!payload.isEmpty()) {
+            // Only the event type is needed here, so scan for it instead of
+            // building a JSON document for every event
+            const ChatEventType eventType = classifyChatEvent(payload.constData(), static_cast<size_t>(payload.size()));
+            inboundEvents[static_cast<size_t>(eventType)].fetch_add(1, std::memory_order_relaxed);
+            const ChatSDKEvent event = chatSDKPushEvent(eventType);
+
+            // The index is kept current even for events nobody subscribed to
+            QString convoId;
+            qint64 deliveryLatencyNs = -1;
+            switch (eventType) {
+            case ChatEventType::NewMessage:
+                convoId = extractConversationId(payload);
+                if (chat) {
+                    chat->conversationIndex.touch(convoId, pending.receivedAtMs);
+                }
+                break;
+            case ChatEventType::NewConversation:
+                convoId = chat ? chat->conversationIndex.upsert(payload) : extractConversationId(payload);
+                break;
+            case ChatEventType::DeliveryAck:
+                convoId = extractConversationId(payload);
+                if (chat) {
+                    chat->conversationIndex.acknowledge(convoId, pending.receivedAtMs);
+                }
+                deliveryLatencyNs = acknowledgeDelivery(chat, payload, pending.receivedAtNs);
+                break;
+            case ChatEventType::Unknown:
+                break;
+            }
+
+            // Drop unwanted events before anything is marshalled
+            if (!subscriptions.wants(event)) {
+                break;
+            }
+            if (eventType != ChatEventType::Unknown && !subscriptions.wantsConversation(convoId)) {
+                break;
+            }
+
+            QVariantList eventData;
+            eventData << jsonPayload(event, payload);
+            eventData << timestamp;
+            if (eventType == ChatEventType::NewMessage) {
+                // Hand consumers the decoded bytes so they do not have to
+                // unwrap the hex content themselves
+                eventData << rawPayload(extractMessageContent(payload));  // raw message content
+            } else if (eventType == ChatEventType::DeliveryAck) {
+                eventData << (deliveryLatencyNs < 0 ? deliveryLatencyNs : deliveryLatencyNs / 1000);  // send-to-ack latency, us
+            }
+            eventData << contextHandle;
+
+            emitPushEvent(event, eventData);
+        }
+        break;
+    }
+    case CallbackKind::GetId: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::get_id_callback called with ret:" << callerRet;
+
+        if (!payload.isEmpty() && subscriptions.wants(ChatSDKEvent::GetIdResult)) {
+            QVariantList eventData;
+            eventData << QString::fromUtf8(payload);
+            eventData << timestamp;
+            eventData << requestId;
+            eventData << contextHandle;
+
+            emitEvent(ChatSDKEvent::GetIdResult, eventData);
+        }
+        break;
+    }
+    case CallbackKind::ListConversations: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::list_conversations_callback called with ret:" << callerRet;
+
+        if (!payload.isEmpty()) {
+            if (chat) {
+                chat->conversationIndex.reset(payload);
+            }
+            if (!subscriptions.wants(ChatSDKEvent::ListConversationsResult)) {
+                break;
+            }
+
+            QVariantList eventData;
+            eventData << jsonPayload(ChatSDKEvent::ListConversationsResult, payload);
+            eventData << timestamp;
+            eventData << requestId;
+            eventData << contextHandle;
+
+            emitEvent(ChatSDKEvent::ListConversationsResult, eventData);
+        }
+        break;
+    }
+    case CallbackKind::RefreshConversations: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::refresh_conversations_callback called with ret:" << callerRet;
+
+        // An empty list is reported without a payload
+        bool success = callerRet == RET_OK;
+        if (!chat) {
+            success = false;
+        } else if (success && !payload.isEmpty()) {
+            success = chat->conversationIndex.reset(payload);
+        } else if (success) {
+            chat->conversationIndex.beginSync();
+            chat->conversationIndex.endSync();
+        }
+        if (!subscriptions.wants(ChatSDKEvent::ConversationsRefreshed)) {
+            break;
+        }
+
+        QVariantList eventData;
+        eventData << success;                    // success
+        eventData << (chat ? chat->conversationIndex.size() : 0);   // indexed conversations
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+
+        emitEvent(ChatSDKEvent::ConversationsRefreshed, eventData);
+        break;
+    }
+    case CallbackKind::SeedConversations: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::seed_conversations_callback called with ret:" << callerRet;
+
+        // Internal, so no event; an empty list is reported without a payload
+        if (!chat || callerRet != RET_OK) {
+            qWarning() << "ChatSDKModulePlugin: Cannot seed conversation index, error code:" << callerRet;
+        } else if (!payload.isEmpty()) {
+            chat->conversationIndex.reset(payload);
+        } else {
+            chat->conversationIndex.beginSync();
+            chat->conversationIndex.endSync();
+        }
+        break;
+    }
+    case CallbackKind::StreamConversations: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::stream_conversations_callback called with ret:" << callerRet;
+
+        auto stream = std::make_shared<ConversationStream>();
+        stream->chunkSize = request->chunkSize;
+        stream->timestamp = timestamp;
+        stream->requestId = requestId;
+        stream->contextHandle = contextHandle;
+
+        // An empty list is reported without a payload
+        const qint64 arrayStart = payload.isEmpty() ? 0 : conversationArrayStart(payload);
+        if (callerRet != RET_OK || arrayStart < 0) {
+            if (callerRet == RET_OK) {
+                qWarning() << "ChatSDKModulePlugin: Cannot stream conversations - result is not a conversation list";
+            }
+            stream->failed = true;
+        } else {
+            stream->payload = payload;
+            stream->pos = static_cast<size_t>(arrayStart);
+            if (chat) {
+                chat->conversationIndex.beginSync();
+            }
+        }
+        emitConversationChunk(stream);
+        break;
+    }
+    case CallbackKind::GetConversation: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::get_conversation_callback called with ret:" << callerRet;
+
+        if (!payload.isEmpty()) {
+            if (chat) {
+                chat->conversationIndex.upsert(payload);
+            }
+            if (awaited || !subscriptions.wants(ChatSDKEvent::GetConversationResult)) {
+                break;
+            }
+
+            QVariantList eventData;
+            eventData << jsonPayload(ChatSDKEvent::GetConversationResult, payload);
+            eventData << timestamp;
+            eventData << requestId;
+            eventData << contextHandle;
+
+            emitEvent(ChatSDKEvent::GetConversationResult, eventData);
+        }
+        break;
+    }
+    case CallbackKind::NewPrivateConversation: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::new_private_conversation_callback called with ret:" << callerRet;
+
+        if (chat && callerRet == RET_OK && !payload.isEmpty()) {
+            chat->conversationIndex.upsert(payload);
+        }
+        if (awaited || !subscriptions.wants(ChatSDKEvent::NewPrivateConversationResult)) {
+            break;
+        }
+
+        QVariantList eventData;
+        eventData << (callerRet == RET_OK && !payload.isEmpty());  // success
+        eventData << callerRet;                                      // return code
+        eventData << jsonPayload(ChatSDKEvent::NewPrivateConversationResult, payload);  // conversation JSON
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+
+        emitEvent(ChatSDKEvent::NewPrivateConversationResult, eventData);
+        break;
+    }
+    case CallbackKind::SendMessage: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::send_message_callback called with ret:" << callerRet;
+
+        if (callerRet == RET_OK) {
+            trackDelivery(chat, payload, request->convoId, request->submittedAtNs);
+        }
+
+        // Failures are reported, not retried, so either way the message is done
+        if (request->outboxKey && chat && chat->outbox) {
+            chat->outbox->complete(request->outboxKey);
+            ++outboxDrained;
+            if (!outboxSyncTimer.isActive()) {
+                outboxSyncTimer.start();
+            }
+            drainOutbox(chat);
+        }
+
+        if (awaited || !subscriptions.wants(ChatSDKEvent::SendMessageResult)) {
+            break;
+        }
+
+        QVariantList eventData;
+        eventData << (callerRet == RET_OK);  // success
+        eventData << callerRet;               // return code
+        eventData << jsonPayload(ChatSDKEvent::SendMessageResult, payload);  // result JSON (may contain message ID)
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+        eventData << (request->outboxKey ? QString::number(request->outboxKey, 16) : QString());   // idempotency key
+
+        emitEvent(ChatSDKEvent::SendMessageResult, eventData);
+        break;
+    }
+    case CallbackKind::SendBatchItem:
+    case CallbackKind::BroadcastItem: {
+        SendBatch::Item* item = static_cast<SendBatch::Item*>(pending.context);
+        if (callerRet == RET_OK) {
+            trackDelivery(chat, payload, QString::fromUtf8(item->convoIdUtf8), item->batch->request->submittedAtNs);
+        }
+        item->batch->complete(*item, callerRet, QString::fromUtf8(payload), pending.receivedAtNs, timestamp);
+        break;
+    }
+    case CallbackKind::GetIdentity: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::get_identity_callback called with ret:" << callerRet;
+
+        if (!payload.isEmpty() && subscriptions.wants(ChatSDKEvent::GetIdentityResult)) {
+            QVariantList eventData;
+            eventData << jsonPayload(ChatSDKEvent::GetIdentityResult, payload);
+            eventData << timestamp;
+            eventData << requestId;
+            eventData << contextHandle;
+
+            emitEvent(ChatSDKEvent::GetIdentityResult, eventData);
+        }
+        break;
+    }
+    case CallbackKind::CreateIntroBundle: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::create_intro_bundle_callback called with ret:" << callerRet;
+
+        // Whatever asked for this bundle has it once this event is out
+        scheduleIntroBundleRefill(contextHandle);
+
+        if (awaited || !subscriptions.wants(ChatSDKEvent::CreateIntroBundleResult)) {
+            break;
+        }
+
+        QString bundleStr = QString::fromUtf8(payload);
+
+        QVariantList eventData;
+        eventData << (callerRet == RET_OK && !bundleStr.isEmpty());  // success
+        eventData << callerRet;                                        // return code
+        eventData << bundleStr;                                        // intro bundle string
+        eventData << timestamp;
+        eventData << requestId;
+        eventData << contextHandle;
+
+        emitEvent(ChatSDKEvent::CreateIntroBundleResult, eventData);
+        break;
+    }
+    case CallbackKind::RefillIntroBundle: {
+        qCDebug(lcCallbacks) << "ChatSDKModulePlugin::refill_intro_bundle_callback called with ret:" << callerRet;
+
+        if (!chat) {
+            break;
+        }
+        chat->introBundleRefilling = false;
+
+        // A failed refill is retried on the next handout rather than in a loop
+        if (callerRet != RET_OK || payload.isEmpty()) {
+            ++introBundleRefillFailures;
+            qWarning() << "ChatSDKModulePlugin: Intro bundle refill failed, error code:" << callerRet;
+            break;
+        }
+
+        if (chat->introBundles.size() < introBundlePoolSize) {
+            chat->introBundles << QString::fromUtf8(payload);
+            ++introBundlesRefilled;
+        }
+        refillIntroBundles(chat);
+        break;
+    }
+    }
+
+    if (awaited) {
+        resolve(callerRet, payload);
+    }
+    requestPool.release(request);
+
+    if (freedLane >= 0) {
+        if (ChatContext* live = findContext(contextHandle)) {
+            pumpLanes(live);
+        }
+    }
+}
+
+QVariant ChatSDKModulePlugin::jsonPayload(ChatSDKEvent event, const QByteArray& payload)
+{
+    QVariant shared = sharedPayload(payload);
+    if (shared.isValid()) {
+        return shared;
+    }
+
+    QVariant compressed = compressedPayload(payload);
+    if (compressed.isValid()) {
+        return compressed;
+    }
+
+    const QString& eventName = chatSDKEventName(event);
+    if (structuredEvents.isEmpty() || !structuredEvents.contains(eventName)) {
+        return QString::fromUtf8(payload);
+    }
+
+    // Parse once here so subscribers do not each re-parse the same JSON
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(payload, &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "ChatSDKModulePlugin: Delivering" << eventName << "as raw JSON -" << error.errorString();
+        return QString::fromUtf8(payload);
+    }
+
+    return doc.toVariant();
+}
+
+QVariant ChatSDKModulePlugin::rawPayload(const QByteArray& bytes)
+{
+    QVariant shared = sharedPayload(bytes);
+    if (shared.isValid()) {
+        return shared;
+    }
+
+    QVariant compressed = compressedPayload(bytes);
+    return compressed.isValid() ? compressed : QVariant(bytes);
+}
+
+QVariant ChatSDKModulePlugin::sharedPayload(const QByteArray& bytes)
+{
+    if (sharedMemoryThreshold == 0 || bytes.size() < sharedMemoryThreshold) {
+        return QVariant();
+    }
+
+    // Falls back to the inline path while every segment is held by the consumer
+    SharedPayloadPool::Handle handle;
+    if (!sharedPayloads.store(bytes.constData(), bytes.size(), handle)) {
+        return QVariant();
+    }
+
+    static const QString keyKey = QStringLiteral("sharedMemoryKey");
+    static const QString offsetKey = QStringLiteral("offset");
+    static const QString lengthKey = QStringLiteral("length");
+    static const QString slotKey = QStringLiteral("slot");
+
+    QVariantMap shared;
+    shared[keyKey] = handle.key;
+    shared[offsetKey] = qint64(0);
+    shared[lengthKey] = handle.length;
+    shared[slotKey] = handle.slot;
+    return shared;
+}
+
+QVariant ChatSDKModulePlugin::compressedPayload(const QByteArray& bytes)
+{
+    if (compressionThreshold == 0 || bytes.size() < compressionThreshold) {
+        return QVariant();
+    }
+
+    QByteArray data;
+    if (!payloadCompressor.compress(bytes.constData(), bytes.size(), compressionPrimed, data)) {
+        return QVariant();
+    }
+
+    static const QString compressedKey = QStringLiteral("compressed");
+    static const QString lengthKey = QStringLiteral("length");
+    static const QString dictionaryKey = QStringLiteral("dictionary");
+
+    QVariantMap compressed;
+    compressed[compressedKey] = data;
+    compressed[lengthKey] = qint64(bytes.size());
+    compressed[dictionaryKey] = compressionPrimed;
+    return compressed;
+}
+
+void ChatSDKModulePlugin::emitPushEvent(ChatSDKEvent event, const QVariantList& data)
+{
+    if (!eventBatchingEnabled) {
+        emitEvent(event, data);
+        return;
+    }
+
+    static const QString eventNameKey = QStringLiteral("eventName");
+    static const QString dataKey = QStringLiteral("data");
+
+    QVariantMap entry;
+    entry[eventNameKey] = chatSDKEventName(event);
+    entry[dataKey] = data;
+    eventBatch << entry;
+
+    if (eventBatch.size() >= eventBatchMaxSize) {
+        flushEventBatch();
+    } else if (!eventBatchTimer.isActive()) {
+        // The linger window starts with the first event of the batch
+        eventBatchTimer.start();
+    }
+}
+
+void ChatSDKModulePlugin::flushEventBatch()
+{
+    eventBatchTimer.stop();
+    if (eventBatch.isEmpty()) {
+        return;
+    }
+    if (!subscriptions.wants(ChatSDKEvent::EventBatch)) {
+        eventBatch.clear();
+        return;
+    }
+
+    QVariantList eventData;
+    eventData << eventBatch;          // batched events
+    eventData << eventBatch.size();   // event count
+    eventData << currentTimestamp();
+    eventBatch.clear();
+
+    emitEvent(ChatSDKEvent::EventBatch, eventData);
+}
+
+void ChatSDKModulePlugin::emitConversationChunk(const std::shared_ptr<ConversationStream>& stream)
+{
+    QByteArray chunk;
+    chunk.append('[');
+    int count = 0;
+    bool last = true;
+
+    if (!stream->failed) {
+        const char* data = stream->payload.constData();
+        const size_t len = static_cast<size_t>(stream->payload.size());
+        std::string_view element;
+        while (count < stream->chunkSize && nextJsonArrayElement(data, len, stream->pos, element)) {
+            if (count > 0) {
+                chunk.append(',');
+            }
+            chunk.append(element.data(), static_cast<int>(element.size()));
+            ++count;
+        }
+
+        // Look ahead so the chunk that ends the list is the one flagged as last
+        size_t next = stream->pos;
+        last = !nextJsonArrayElement(data, len, next, element);
+    }
+    chunk.append(']');
+
+    ChatContext* chat = findContext(stream->contextHandle);
+    if (chat && count > 0) {
+        chat->conversationIndex.append(chunk);
+    }
+    if (chat && last && !stream->failed) {
+        chat->conversationIndex.endSync();
+    }
+
+    if (subscriptions.wants(ChatSDKEvent::ConversationsChunk)) {
+        QVariantList eventData;
+        eventData << !stream->failed;                                           // success
+        eventData << jsonPayload(ChatSDKEvent::ConversationsChunk, chunk);      // conversations in this chunk
+        eventData << stream->chunkIndex;                                        // chunk index
+        eventData << last;                                                      // last chunk
+        eventData << stream->timestamp;
+        eventData << stream->requestId;
+        eventData << stream->contextHandle;
+
+        emitEvent(ChatSDKEvent::ConversationsChunk, eventData);
+    }
+
+    // One chunk per event loop iteration keeps other events flowing in between
+    ++stream->chunkIndex;
+    if (!last) {
+        QMetaObject::invokeMethod(this, [this, stream]() { emitConversationChunk(stream); }, Qt::QueuedConnection);
+    }
+}
+
+// ============================================================================
+// Static Callback Functions
+// ============================================================================
+//
+// These run on liblogoschat's threads. They only copy the payload into the
+// callback queue; formatting and emission happen on the plugin thread in
+// deliverCallback().
+
+void ChatSDKModulePlugin::dispatch_callback(ChatContext* chat, CallbackKind kind, int callerRet, const char* msg, size_t len, void* context)
+{
+    // Sequentially consistent on purpose: pairs with the detached store and
+    // activeCallbacks load in detachContexts()
+    chat->activeCallbacks.fetch_add(1);
+    if (!chat->detached.load()) {
+        chat->plugin->enqueueCallback(kind, callerRet, msg, len, context);
+    }
+    if (kind != CallbackKind::Event) {
+        chat->pendingCallbacks.fetch_sub(1);
+    }
+    chat->activeCallbacks.fetch_sub(1);
+}
+
+void ChatSDKModulePlugin::forward_callback(CallbackKind kind, int callerRet, const char* msg, size_t len, void* userData)
+{
+    RequestContext* request = static_cast<RequestContext*>(userData);
+    if (!request || !request->chat) {
+        qWarning() << "ChatSDKModulePlugin: callback received invalid userData";
+        return;
+    }
+
+    // The request may be recycled as soon as it is queued; its context is not
+    dispatch_callback(request->chat, kind, callerRet, msg, len, request);
+}
+
+void ChatSDKModulePlugin::init_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::Init, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::start_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::Start, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::stop_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::Stop, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::destroy_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::Destroy, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::event_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    // Push events are not tied to a request; userData is their chat context
+    ChatContext* chat = static_cast<ChatContext*>(userData);
+    if (!chat || !chat->plugin) {
+        qWarning() << "ChatSDKModulePlugin::event_callback: Invalid userData";
+        return;
+    }
+
+    dispatch_callback(chat, CallbackKind::Event, callerRet, msg, len, chat);
+}
+
+void ChatSDKModulePlugin::get_id_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::GetId, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::list_conversations_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::ListConversations, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::refresh_conversations_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::RefreshConversations, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::seed_conversations_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::SeedConversations, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::stream_conversations_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::StreamConversations, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::get_conversation_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::GetConversation, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::new_private_conversation_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::NewPrivateConversation, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::send_message_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::SendMessage, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::send_batch_item_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    SendBatch::Item* item = static_cast<SendBatch::Item*>(userData);
+    if (!item || !item->batch) {
+        qWarning() << "ChatSDKModulePlugin::send_batch_item_callback: Invalid userData";
+        return;
+    }
+
+    dispatch_callback(item->batch->request->chat, item->batch->request->kind, callerRet, msg, len, item);
+}
+
+void ChatSDKModulePlugin::get_identity_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::GetIdentity, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::create_intro_bundle_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::CreateIntroBundle, callerRet, msg, len, userData);
+}
+
+void ChatSDKModulePlugin::refill_intro_bundle_callback(int callerRet, const char* msg, size_t len, void* userData)
+{
+    forward_callback(CallbackKind::RefillIntroBundle, callerRet, msg, len, userData);
+}
+
+// ============================================================================
+// Client Lifecycle Methods
+// ============================================================================
+
+qint64 ChatSDKModulePlugin::initChat(const QString &configJson)
+{
+    qDebug() << "ChatSDKModulePlugin::initChat called with config:" << configJson;
+
+    // A second init would orphan the first context
+    if (findContext(defaultContextHandle)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot init Chat - already initialized. Call destroyChat first.";
+        return 0;
+    }
+
+    qint64 requestId = 0;
+    const qint64 contextHandle = createContext(configJson, requestId);
+    if (!contextHandle) {
+        return 0;
+    }
+
+    defaultContextHandle = contextHandle;
+    return requestId;
+}
+
+qint64 ChatSDKModulePlugin::startChat()
+{
+    return startChatInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::startChatInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::startChat called";
+    
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot start Chat - context not initialized. Call initChat first.";
+        return 0;
+    }
+
+    if (!chat->advance(LifecycleState::Initialized, LifecycleState::Running)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot start Chat - client is" << lifecycleStateName(chat->state.load());
+        return 0;
+    }
+    
+    RequestContext* request = beginRequest(CallbackKind::Start, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_start(chat->ctx, start_callback, request);
+    });
+    
+    if (result == RET_OK) {
+        qDebug() << "ChatSDKModulePlugin: Chat start initiated successfully";
+        return requestId;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to start Chat, error code:" << result;
+        chat->advance(LifecycleState::Running, LifecycleState::Initialized);
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+qint64 ChatSDKModulePlugin::stopChat()
+{
+    return stopChatInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::stopChatInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::stopChat called";
+    
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot stop Chat - context not initialized.";
+        return 0;
+    }
+
+    if (!chat->advance(LifecycleState::Running, LifecycleState::Stopping)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot stop Chat - client is" << lifecycleStateName(chat->state.load());
+        return 0;
     }
     
-    int result = chat_stop(chatCtx, stop_callback, this);
-    
+    RequestContext* request = beginRequest(CallbackKind::Stop, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_stop(chat->ctx, stop_callback, request);
+    });
+    
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: Chat stop initiated successfully";
-        return true;
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to stop Chat, error code:" << result;
-        return false;
+        chat->advance(LifecycleState::Stopping, LifecycleState::Running);
+        cancelRequest(request);
+        return 0;
     }
 }
 
-bool ChatSDKModulePlugin::destroyChat()
+qint64 ChatSDKModulePlugin::destroyChat()
+{
+    return destroyChatInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::destroyChatInContext(qint64 contextHandle)
 {
     qDebug() << "ChatSDKModulePlugin::destroyChat called";
     
-    if (!chatCtx) {
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
         qWarning() << "ChatSDKModulePlugin: Cannot destroy Chat - context not initialized.";
-        return false;
+        return 0;
     }
+
+    // Fails every later request for the context before the SDK frees it
+    const LifecycleState previous = chat->state.exchange(LifecycleState::Destroyed, std::memory_order_acq_rel);
+    rejectHeldCalls(chat);
     
-    int result = chat_destroy(chatCtx, destroy_callback, this);
+    RequestContext* request = beginRequest(CallbackKind::Destroy, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = chat_destroy(chat->ctx, destroy_callback, request);
+    recordSubmission(CallbackKind::Destroy, result);
     
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: Chat destroy initiated successfully";
-        chatCtx = nullptr;
-        return true;
+        // No new requests reach the context from here on; it is freed once
+        // its destroy callback has been delivered
+        chatContexts.remove(contextHandle);
+        retiredContexts.insert(contextHandle, chat);
+        if (defaultContextHandle == contextHandle) {
+            defaultContextHandle = 0;
+        }
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to destroy Chat, error code:" << result;
+        chat->state.store(previous, std::memory_order_release);
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+qint64 ChatSDKModulePlugin::bootChat(const QString &configJson)
+{
+    qDebug() << "ChatSDKModulePlugin::bootChat called with config:" << configJson;
+
+    if (findContext(defaultContextHandle)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot boot Chat - already initialized. Call destroyChat first.";
+        return 0;
+    }
+
+    const qint64 startedAtNs = monotonicNowNs();
+    qint64 initRequestId = 0;
+    const qint64 contextHandle = createContext(configJson, initRequestId);
+    if (!contextHandle) {
+        return 0;
+    }
+    ChatContext* chat = chatContexts.value(contextHandle);
+
+    // Wired before the client can start, so the first push event has somewhere to go
+    const qint64 wiringStartedAtNs = monotonicNowNs();
+    set_event_callback(chat->ctx, event_callback, chat);
+    chat->boot.wiringNs = monotonicNowNs() - wiringStartedAtNs;
+
+    // The init callback is delivered through the queue, so this is set before it is seen
+    chat->boot.requestId = ++lastRequestId;
+    chat->boot.initRequestId = initRequestId;
+    chat->boot.startedAtNs = startedAtNs;
+
+    defaultContextHandle = contextHandle;
+    return chat->boot.requestId;
+}
+
+void ChatSDKModulePlugin::continueBoot(ChatContext* chat, int callerRet, const QByteArray& payload, qint64 initAtNs, const QVariant& timestamp)
+{
+    chat->boot.initAtNs = initAtNs;
+    if (callerRet != RET_OK) {
+        finishBoot(chat, callerRet, payload, initAtNs, timestamp);
+        return;
+    }
+
+    if (!chat->advance(LifecycleState::Initialized, LifecycleState::Running)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot finish boot - client is" << lifecycleStateName(chat->state.load());
+        finishBoot(chat, kNoContextError, QByteArray(), monotonicNowNs(), currentTimestamp());
+        return;
+    }
+
+    RequestContext* request = beginRequest(CallbackKind::Start, chat);
+    chat->boot.startRequestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_start(chat->ctx, start_callback, request);
+    });
+
+    if (result != RET_OK) {
+        qWarning() << "ChatSDKModulePlugin: Failed to start Chat during boot, error code:" << result;
+        chat->advance(LifecycleState::Running, LifecycleState::Initialized);
+        chat->boot.startSubmittedAtNs = request->submittedAtNs;
+        cancelRequest(request);
+        finishBoot(chat, result, QByteArray(), monotonicNowNs(), currentTimestamp());
+    }
+}
+
+void ChatSDKModulePlugin::finishBoot(ChatContext* chat, int callerRet, const QByteArray& payload, qint64 finishedAtNs, const QVariant& timestamp)
+{
+    const BootProgress boot = chat->boot;
+    chat->boot = BootProgress();
+
+    const bool started = boot.startRequestId != 0;
+    const bool success = callerRet == RET_OK && started;
+    qDebug() << "ChatSDKModulePlugin: Boot of context" << chat->handle << (success ? "succeeded" : "failed")
+             << "in" << (finishedAtNs - boot.startedAtNs) / 1000 << "us";
+
+    if (!subscriptions.wants(ChatSDKEvent::BootResult)) {
+        return;
+    }
+
+    QVariantMap phases;
+    phases["chatNewUs"] = (boot.initAtNs - boot.startedAtNs) / 1000;
+    phases["callbackWiringUs"] = boot.wiringNs / 1000;
+    phases["startUs"] = boot.startSubmittedAtNs ? (finishedAtNs - boot.startSubmittedAtNs) / 1000 : qint64(-1);
+    phases["totalUs"] = (finishedAtNs - boot.startedAtNs) / 1000;
+    phases["failedPhase"] = success ? QString() : QString::fromLatin1(started ? "chat_start" : "chat_new");
+
+    QVariantList eventData;
+    eventData << success;                      // success boolean
+    eventData << callerRet;                    // return code
+    eventData << QString::fromUtf8(payload);   // message (may be empty)
+    eventData << phases;                       // phase timings
+    eventData << timestamp;
+    eventData << boot.requestId;
+    eventData << chat->handle;
+
+    emitEvent(ChatSDKEvent::BootResult, eventData);
+}
+
+bool ChatSDKModulePlugin::setEventCallback()
+{
+    return setEventCallbackInContext(defaultContextHandle);
+}
+
+bool ChatSDKModulePlugin::setEventCallbackInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::setEventCallback called";
+    
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set event callback - context not initialized. Call initChat first.";
+        return false;
+    }
+    
+    set_event_callback(chat->ctx, event_callback, chat);
+    
+    qDebug() << "ChatSDKModulePlugin: Event callback set successfully";
+    return true;
+}
+
+bool ChatSDKModulePlugin::setEventBatching(bool enabled, int maxBatchSize, int maxLingerMs)
+{
+    qDebug() << "ChatSDKModulePlugin::setEventBatching called with enabled:" << enabled
+             << "maxBatchSize:" << maxBatchSize << "maxLingerMs:" << maxLingerMs;
+
+    if (maxBatchSize <= 0 || maxLingerMs < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set event batching - invalid batch size or linger time";
+        return false;
+    }
+
+    eventBatchMaxSize = maxBatchSize;
+    eventBatchTimer.setInterval(maxLingerMs);
+    eventBatchingEnabled = enabled;
+
+    // Events collected so far must not outlive the mode they were batched in
+    if (!enabled || eventBatch.size() >= eventBatchMaxSize) {
+        flushEventBatch();
+    }
+    return true;
+}
+
+bool ChatSDKModulePlugin::setStructuredDelivery(const QString &eventName, bool enabled)
+{
+    qDebug() << "ChatSDKModulePlugin::setStructuredDelivery called for" << eventName << "enabled:" << enabled;
+
+    static const QSet<QString> jsonEvents = []() {
+        QSet<QString> names;
+        for (int i = 0; i < static_cast<int>(ChatSDKEvent::Count); ++i) {
+            const ChatSDKEvent event = static_cast<ChatSDKEvent>(i);
+            if (chatSDKEventCarriesJson(event)) {
+                names.insert(chatSDKEventName(event));
+            }
+        }
+        return names;
+    }();
+
+    if (!jsonEvents.contains(eventName)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set structured delivery -" << eventName << "does not carry a JSON payload";
+        return false;
+    }
+
+    if (enabled) {
+        structuredEvents.insert(eventName);
+    } else {
+        structuredEvents.remove(eventName);
+    }
+    return true;
+}
+
+bool ChatSDKModulePlugin::subscribe(const QString &eventName)
+{
+    qDebug() << "ChatSDKModulePlugin::subscribe called for" << eventName;
+
+    if (!subscriptions.subscribe(eventName)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot subscribe -" << eventName << "is not a chatsdk event";
+        return false;
+    }
+    return true;
+}
+
+bool ChatSDKModulePlugin::unsubscribe(const QString &eventName)
+{
+    qDebug() << "ChatSDKModulePlugin::unsubscribe called for" << eventName;
+
+    if (!subscriptions.unsubscribe(eventName)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot unsubscribe -" << eventName << "is not a chatsdk event";
+        return false;
+    }
+    return true;
+}
+
+bool ChatSDKModulePlugin::setConversationFilter(const QStringList &convoIds)
+{
+    qDebug() << "ChatSDKModulePlugin::setConversationFilter called with" << convoIds.size() << "conversations";
+
+    subscriptions.setConversationFilter(convoIds);
+    return true;
+}
+
+bool ChatSDKModulePlugin::setIsoTimestamps(bool enabled)
+{
+    qDebug() << "ChatSDKModulePlugin::setIsoTimestamps called with enabled:" << enabled;
+
+    isoTimestamps = enabled;
+    return true;
+}
+
+bool ChatSDKModulePlugin::setSharedMemoryThreshold(int thresholdBytes)
+{
+    qDebug() << "ChatSDKModulePlugin::setSharedMemoryThreshold called with" << thresholdBytes << "bytes";
+
+    if (thresholdBytes < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set shared memory threshold - threshold is negative";
+        return false;
+    }
+
+    sharedMemoryThreshold = thresholdBytes;
+    return true;
+}
+
+bool ChatSDKModulePlugin::releaseSharedPayload(qint64 slot)
+{
+    if (!sharedPayloads.release(slot)) {
+        qWarning() << "ChatSDKModulePlugin: Cannot release shared payload - unknown slot" << slot;
+        return false;
+    }
+    return true;
+}
+
+bool ChatSDKModulePlugin::setPayloadCompression(int thresholdBytes, bool primedDictionary)
+{
+    qDebug() << "ChatSDKModulePlugin::setPayloadCompression called with" << thresholdBytes << "bytes, primed dictionary:" << primedDictionary;
+
+    if (thresholdBytes < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set payload compression - threshold is negative";
         return false;
     }
+
+    compressionThreshold = thresholdBytes;
+    compressionPrimed = primedDictionary;
+    return true;
+}
+
+QByteArray ChatSDKModulePlugin::getCompressionDictionary() const
+{
+    return PayloadCompressor::dictionary();
+}
+
+// ============================================================================
+// Client Info Methods
+// ============================================================================
+
+qint64 ChatSDKModulePlugin::getId()
+{
+    return getIdInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::getIdInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::getId called";
+    
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot get ID - context not initialized";
+        return 0;
+    }
+    
+    RequestContext* request = beginRequest(CallbackKind::GetId, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_get_id(chat->ctx, get_id_callback, request);
+    });
+    
+    if (result == RET_OK) {
+        qDebug() << "ChatSDKModulePlugin: Get ID initiated successfully";
+        return requestId;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to get ID, error code:" << result;
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+// ============================================================================
+// Conversation Operations
+// ============================================================================
+
+qint64 ChatSDKModulePlugin::listConversations()
+{
+    return listConversationsInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::listConversationsInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::listConversations called";
+    
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot list conversations - context not initialized";
+        return 0;
+    }
+    
+    RequestContext* request = beginRequest(CallbackKind::ListConversations, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_list_conversations(chat->ctx, list_conversations_callback, request);
+    });
+    
+    if (result == RET_OK) {
+        qDebug() << "ChatSDKModulePlugin: List conversations initiated successfully";
+        return requestId;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to list conversations, error code:" << result;
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+qint64 ChatSDKModulePlugin::refreshConversations()
+{
+    return refreshConversationsInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::refreshConversationsInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::refreshConversations called";
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot refresh conversations - context not initialized";
+        return 0;
+    }
+
+    RequestContext* request = beginRequest(CallbackKind::RefreshConversations, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_list_conversations(chat->ctx, refresh_conversations_callback, request);
+    });
+
+    if (result == RET_OK) {
+        qDebug() << "ChatSDKModulePlugin: Refresh conversations initiated successfully";
+        return requestId;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to refresh conversations, error code:" << result;
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+void ChatSDKModulePlugin::seedConversations(ChatContext* chat)
+{
+    RequestContext* request = beginRequest(CallbackKind::SeedConversations, chat);
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_list_conversations(chat->ctx, seed_conversations_callback, request);
+    });
+
+    if (result != RET_OK) {
+        qWarning() << "ChatSDKModulePlugin: Failed to seed conversation index, error code:" << result;
+        cancelRequest(request);
+    }
+}
+
+qint64 ChatSDKModulePlugin::streamConversations(int chunkSize)
+{
+    return streamConversationsInContext(defaultContextHandle, chunkSize);
+}
+
+qint64 ChatSDKModulePlugin::streamConversationsInContext(qint64 contextHandle, int chunkSize)
+{
+    qDebug() << "ChatSDKModulePlugin::streamConversations called with chunk size" << chunkSize;
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot stream conversations - context not initialized";
+        return 0;
+    }
+
+    if (chunkSize < 1) {
+        qWarning() << "ChatSDKModulePlugin: Cannot stream conversations - chunk size must be positive";
+        return 0;
+    }
+
+    RequestContext* request = beginRequest(CallbackKind::StreamConversations, chat);
+    request->chunkSize = chunkSize;
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_list_conversations(chat->ctx, stream_conversations_callback, request);
+    });
+
+    if (result == RET_OK) {
+        qDebug() << "ChatSDKModulePlugin: Stream conversations initiated successfully";
+        return requestId;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to stream conversations, error code:" << result;
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+QVariantList ChatSDKModulePlugin::listConversationsSync() const
+{
+    return listConversationsSyncInContext(defaultContextHandle);
+}
+
+QVariantList ChatSDKModulePlugin::listConversationsSyncInContext(qint64 contextHandle) const
+{
+    const ChatContext* chat = findContext(contextHandle);
+    return chat ? chat->conversationIndex.list() : QVariantList();
 }
 
-bool ChatSDKModulePlugin::setEventCallback()
+QVariantMap ChatSDKModulePlugin::getConversationSync(const QString &convoId) const
 {
-    qDebug() << "ChatSDKModulePlugin::setEventCallback called";
-    
-    if (!chatCtx) {
-        qWarning() << "ChatSDKModulePlugin: Cannot set event callback - context not initialized. Call initChat first.";
-        return false;
-    }
-    
-    set_event_callback(chatCtx, event_callback, this);
-    
-    qDebug() << "ChatSDKModulePlugin: Event callback set successfully";
-    return true;
+    return getConversationSyncInContext(defaultContextHandle, convoId);
 }
 
-// ============================================================================
-// Client Info Methods
-// ============================================================================
+QVariantMap ChatSDKModulePlugin::getConversationSyncInContext(qint64 contextHandle, const QString &convoId) const
+{
+    const ChatContext* chat = findContext(contextHandle);
+    return chat ? chat->conversationIndex.get(convoId) : QVariantMap();
+}
 
-bool ChatSDKModulePlugin::getId()
+QVariantMap ChatSDKModulePlugin::listConversationsSince(qint64 version) const
 {
-    qDebug() << "ChatSDKModulePlugin::getId called";
-    
-    if (!chatCtx) {
-        qWarning() << "ChatSDKModulePlugin: Cannot get ID - context not initialized";
-        return false;
-    }
-    
-    int result = chat_get_id(chatCtx, get_id_callback, this);
-    
-    if (result == RET_OK) {
-        qDebug() << "ChatSDKModulePlugin: Get ID initiated successfully";
-        return true;
-    } else {
-        qWarning() << "ChatSDKModulePlugin: Failed to get ID, error code:" << result;
-        return false;
+    return listConversationsSinceInContext(defaultContextHandle, version);
+}
+
+QVariantMap ChatSDKModulePlugin::listConversationsSinceInContext(qint64 contextHandle, qint64 version) const
+{
+    const ChatContext* chat = findContext(contextHandle);
+    if (!chat || version < 0) {
+        return QVariantMap();
     }
+
+    bool full = false;
+    const QVariantList conversations = chat->conversationIndex.changedSince(static_cast<quint64>(version), full);
+
+    QVariantMap delta;
+    delta["conversations"] = conversations;
+    delta["version"] = static_cast<qint64>(chat->conversationIndex.version());
+    delta["full"] = full;
+    return delta;
 }
 
-// ============================================================================
-// Conversation Operations
-// ============================================================================
+QVariantMap ChatSDKModulePlugin::listConversationsPage(const QString &cursor, int limit) const
+{
+    return listConversationsPageInContext(defaultContextHandle, cursor, limit);
+}
 
-bool ChatSDKModulePlugin::listConversations()
+QVariantMap ChatSDKModulePlugin::listConversationsPageInContext(qint64 contextHandle, const QString &cursor, int limit) const
 {
-    qDebug() << "ChatSDKModulePlugin::listConversations called";
-    
-    if (!chatCtx) {
-        qWarning() << "ChatSDKModulePlugin: Cannot list conversations - context not initialized";
-        return false;
+    const ChatContext* chat = findContext(contextHandle);
+    if (!chat || limit < 1) {
+        return QVariantMap();
     }
-    
-    int result = chat_list_conversations(chatCtx, list_conversations_callback, this);
-    
-    if (result == RET_OK) {
-        qDebug() << "ChatSDKModulePlugin: List conversations initiated successfully";
-        return true;
-    } else {
-        qWarning() << "ChatSDKModulePlugin: Failed to list conversations, error code:" << result;
-        return false;
+
+    QString nextCursor;
+    bool found = false;
+    const QVariantList conversations = chat->conversationIndex.page(cursor, limit, nextCursor, found);
+    if (!found) {
+        qWarning() << "ChatSDKModulePlugin: Conversation page cursor" << cursor << "is no longer indexed";
+        return QVariantMap();
     }
+
+    QVariantMap page;
+    page["conversations"] = conversations;
+    page["nextCursor"] = nextCursor;
+    page["total"] = chat->conversationIndex.size();
+    return page;
 }
 
-bool ChatSDKModulePlugin::getConversation(const QString &convoId)
+qint64 ChatSDKModulePlugin::getConversation(const QString &convoId)
+{
+    return getConversationInContext(defaultContextHandle, convoId);
+}
+
+qint64 ChatSDKModulePlugin::getConversationInContext(qint64 contextHandle, const QString &convoId)
 {
     qDebug() << "ChatSDKModulePlugin::getConversation called with convoId:" << convoId;
     
-    if (!chatCtx) {
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
         qWarning() << "ChatSDKModulePlugin: Cannot get conversation - context not initialized";
-        return false;
+        return 0;
     }
     
     QByteArray convoIdUtf8 = convoId.toUtf8();
     
-    int result = chat_get_conversation(chatCtx, get_conversation_callback, this, convoIdUtf8.constData());
+    RequestContext* request = beginRequest(CallbackKind::GetConversation, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request, convoIdUtf8]() {
+        return chat_get_conversation(chat->ctx, get_conversation_callback, request, convoIdUtf8.constData());
+    });
     
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: Get conversation initiated successfully";
-        return true;
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to get conversation, error code:" << result;
-        return false;
+        cancelRequest(request);
+        return 0;
     }
 }
 
-bool ChatSDKModulePlugin::newPrivateConversation(const QString &introBundleStr, const QString &contentHex)
+qint64 ChatSDKModulePlugin::newPrivateConversation(const QString &introBundleStr, const QString &contentHex)
+{
+    return newPrivateConversationInContext(defaultContextHandle, introBundleStr, contentHex);
+}
+
+qint64 ChatSDKModulePlugin::newPrivateConversationInContext(qint64 contextHandle, const QString &introBundleStr, const QString &contentHex)
 {
     qDebug() << "ChatSDKModulePlugin::newPrivateConversation called";
 
-    if (!chatCtx) {
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
         qWarning() << "ChatSDKModulePlugin: Cannot create new private conversation - context not initialized";
-        return false;
+        return 0;
     }
 
     QByteArray introBundleUtf8 = introBundleStr.toUtf8();
     QByteArray contentUtf8 = contentHex.toUtf8();
     
-    int result = chat_new_private_conversation(chatCtx, new_private_conversation_callback, this, introBundleUtf8.constData(), contentUtf8.constData());
+    RequestContext* request = beginRequest(CallbackKind::NewPrivateConversation, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request, introBundleUtf8, contentUtf8]() {
+        return chat_new_private_conversation(chat->ctx, new_private_conversation_callback, request, introBundleUtf8.constData(), contentUtf8.constData());
+    });
     
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: New private conversation initiated successfully";
-        return true;
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to create new private conversation, error code:" << result;
-        return false;
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+qint64 ChatSDKModulePlugin::newPrivateConversationBytes(const QString &introBundleStr, const QByteArray &content)
+{
+    return newPrivateConversationBytesInContext(defaultContextHandle, introBundleStr, content);
+}
+
+qint64 ChatSDKModulePlugin::newPrivateConversationBytesInContext(qint64 contextHandle, const QString &introBundleStr, const QByteArray &content)
+{
+    qDebug() << "ChatSDKModulePlugin::newPrivateConversationBytes called with" << content.size() << "bytes";
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot create new private conversation - context not initialized";
+        return 0;
+    }
+
+    QByteArray introBundleUtf8 = introBundleStr.toUtf8();
+    // liblogoschat takes hex content; encode once straight into the C buffer
+    QByteArray contentHex = content.toHex();
+
+    RequestContext* request = beginRequest(CallbackKind::NewPrivateConversation, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request, introBundleUtf8, contentHex]() {
+        return chat_new_private_conversation(chat->ctx, new_private_conversation_callback, request, introBundleUtf8.constData(), contentHex.constData());
+    });
+
+    if (result == RET_OK) {
+        qDebug() << "ChatSDKModulePlugin: New private conversation initiated successfully";
+        return requestId;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to create new private conversation, error code:" << result;
+        cancelRequest(request);
+        return 0;
     }
 }
 
-bool ChatSDKModulePlugin::sendMessage(const QString &convoId, const QString &contentHex)
+qint64 ChatSDKModulePlugin::sendMessage(const QString &convoId, const QString &contentHex)
+{
+    return sendMessageInContext(defaultContextHandle, convoId, contentHex);
+}
+
+qint64 ChatSDKModulePlugin::sendMessageInContext(qint64 contextHandle, const QString &convoId, const QString &contentHex)
 {
     qDebug() << "ChatSDKModulePlugin::sendMessage called with convoId:" << convoId;
     
-    if (!chatCtx) {
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
         qWarning() << "ChatSDKModulePlugin: Cannot send message - context not initialized";
-        return false;
+        return 0;
     }
     
+    return submitMessage(chat, convoId, contentHex.toUtf8());
+}
+
+qint64 ChatSDKModulePlugin::sendMessageBytes(const QString &convoId, const QByteArray &content)
+{
+    return sendMessageBytesInContext(defaultContextHandle, convoId, content);
+}
+
+qint64 ChatSDKModulePlugin::sendMessageBytesInContext(qint64 contextHandle, const QString &convoId, const QByteArray &content)
+{
+    qDebug() << "ChatSDKModulePlugin::sendMessageBytes called with convoId:" << convoId;
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot send message - context not initialized";
+        return 0;
+    }
+
+    // liblogoschat takes hex content; encode once straight into the C buffer
+    return submitMessage(chat, convoId, content.toHex());
+}
+
+qint64 ChatSDKModulePlugin::submitMessage(ChatContext* chat, const QString& convoId, const QByteArray& contentHex)
+{
+    // Queued messages go first, so later sends cannot overtake them
+    if (chat->outbox && (chat->state.load() != LifecycleState::Running || chat->outbox->pending() > 0)) {
+        return queueInOutbox(chat, convoId, contentHex);
+    }
+
     QByteArray convoIdUtf8 = convoId.toUtf8();
-    QByteArray contentUtf8 = contentHex.toUtf8();
-    
-    int result = chat_send_message(chatCtx, send_message_callback, this, convoIdUtf8.constData(), contentUtf8.constData());
-    
+
+    RequestContext* request = beginRequest(CallbackKind::SendMessage, chat);
+    request->convoId = convoId;
+    const qint64 requestId = request->requestId;
+
+    // A held send the SDK turns away later is kept for retry, as it would be now
+    auto reject = [this, chat, request, convoId, contentHex](int result) {
+        if (chat->outbox && queueInOutbox(chat, convoId, contentHex, request->requestId)) {
+            cancelRequest(request);
+        } else {
+            rejectRequest(request, result);
+        }
+    };
+
+    int result = submitRequest(request, operationLanes[static_cast<size_t>(CallbackKind::SendMessage)],
+                               [chat, request, convoIdUtf8, contentHex]() {
+        return chat_send_message(chat->ctx, send_message_callback, request, convoIdUtf8.constData(), contentHex.constData());
+    }, reject);
+
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: Send message initiated successfully";
-        return true;
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to send message, error code:" << result;
-        return false;
+        cancelRequest(request);
+        return chat->outbox ? queueInOutbox(chat, convoId, contentHex) : 0;
+    }
+}
+
+qint64 ChatSDKModulePlugin::sendMessages(const QVariantList &messages)
+{
+    return sendMessagesInContext(defaultContextHandle, messages);
+}
+
+qint64 ChatSDKModulePlugin::sendMessagesInContext(qint64 contextHandle, const QVariantList &messages)
+{
+    qDebug() << "ChatSDKModulePlugin::sendMessages called with" << messages.size() << "messages";
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot send messages - context not initialized";
+        return 0;
+    }
+
+    if (messages.isEmpty()) {
+        qWarning() << "ChatSDKModulePlugin: Cannot send messages - batch is empty";
+        return 0;
+    }
+
+    // Marshal the whole batch before issuing any send so a malformed entry
+    // rejects the batch without partially sending it.
+    SendBatch* batch = new SendBatch;
+    batch->plugin = this;
+    batch->items.resize(messages.size());
+
+    for (int i = 0; i < messages.size(); ++i) {
+        const QVariant& entry = messages.at(i);
+        QString convoId;
+        QString contentHex;
+
+        if (entry.canConvert<QVariantMap>() && entry.toMap().contains("convoId")) {
+            const QVariantMap map = entry.toMap();
+            convoId = map.value("convoId").toString();
+            contentHex = map.value("contentHex").toString();
+        } else if (entry.canConvert<QVariantList>() && entry.toList().size() == 2) {
+            const QVariantList pair = entry.toList();
+            convoId = pair.at(0).toString();
+            contentHex = pair.at(1).toString();
+        }
+
+        if (convoId.isEmpty()) {
+            qWarning() << "ChatSDKModulePlugin: Cannot send messages - malformed entry at index" << i;
+            delete batch;
+            return 0;
+        }
+
+        SendBatch::Item& item = batch->items[i];
+        item.batch = batch;
+        item.index = i;
+        item.convoIdUtf8 = convoId.toUtf8();
+        item.contentUtf8 = contentHex.toUtf8();
+    }
+
+    const qint64 requestId = submitBatch(batch, chat, CallbackKind::SendBatchItem);
+    qDebug() << "ChatSDKModulePlugin: Send messages initiated for" << messages.size() << "messages";
+    return requestId;
+}
+
+qint64 ChatSDKModulePlugin::broadcastMessage(const QStringList &convoIds, const QByteArray &content)
+{
+    return broadcastMessageInContext(defaultContextHandle, convoIds, content);
+}
+
+qint64 ChatSDKModulePlugin::broadcastMessageInContext(qint64 contextHandle, const QStringList &convoIds, const QByteArray &content)
+{
+    qDebug() << "ChatSDKModulePlugin::broadcastMessage called for" << convoIds.size() << "conversations";
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot broadcast message - context not initialized";
+        return 0;
+    }
+
+    if (convoIds.isEmpty()) {
+        qWarning() << "ChatSDKModulePlugin: Cannot broadcast message - no conversations given";
+        return 0;
+    }
+
+    for (int i = 0; i < convoIds.size(); ++i) {
+        if (convoIds.at(i).isEmpty()) {
+            qWarning() << "ChatSDKModulePlugin: Cannot broadcast message - empty conversation ID at index" << i;
+            return 0;
+        }
     }
+
+    // The content is encoded once and every send reads the same buffer
+    SendBatch* batch = new SendBatch;
+    batch->plugin = this;
+    batch->sharedContent = content.toHex();
+    batch->items.resize(convoIds.size());
+
+    for (int i = 0; i < convoIds.size(); ++i) {
+        SendBatch::Item& item = batch->items[i];
+        item.batch = batch;
+        item.index = i;
+        item.convoIdUtf8 = convoIds.at(i).toUtf8();
+    }
+
+    const qint64 requestId = submitBatch(batch, chat, CallbackKind::BroadcastItem);
+    qDebug() << "ChatSDKModulePlugin: Broadcast initiated to" << convoIds.size() << "conversations";
+    return requestId;
+}
+
+qint64 ChatSDKModulePlugin::submitBatch(SendBatch* batch, ChatContext* chat, CallbackKind kind)
+{
+    // Completions are delivered on this thread once control returns to the
+    // event loop, synchronous rejections included, so the caller always has
+    // the request ID before the aggregated result is emitted.
+    const int count = static_cast<int>(batch->items.size());
+    batch->remaining = count;
+    batch->request = beginRequest(kind, chat);
+    const qint64 requestId = batch->request->requestId;
+
+    // Every entry is a call of its own in the batch's lane
+    const int lane = operationLanes[static_cast<size_t>(kind)];
+
+    // One callback is owed per entry, not per request
+    chat->pendingCallbacks.fetch_add(count - 1);
+
+    for (int i = 0; i < count; ++i) {
+        SendBatch::Item* item = &batch->items[i];
+        auto fail = [this, chat, item](int result) {
+            chat->pendingCallbacks.fetch_sub(1);
+            const qint64 failedAtNs = monotonicNowNs();
+            QMetaObject::invokeMethod(this, [this, item, result, failedAtNs]() {
+                item->batch->complete(*item, result, "", failedAtNs, currentTimestamp());
+            }, Qt::QueuedConnection);
+        };
+
+        int result = scheduleCall(chat, lane, requestId, [this, chat, item, kind](int issuedLane) {
+            const int status = chat_send_message(chat->ctx, send_batch_item_callback, item,
+                                                 item->convoIdUtf8.constData(), item->content());
+            recordSubmission(kind, status);
+            if (status == RET_OK) {
+                item->lane = issuedLane;
+            }
+            return status;
+        }, fail);
+        if (result != RET_OK) {
+            qWarning() << "ChatSDKModulePlugin: Failed to send batch message" << i << ", error code:" << result;
+            fail(result);
+        }
+    }
+
+    return requestId;
 }
 
 // ============================================================================
 // Identity Operations
 // ============================================================================
 
-bool ChatSDKModulePlugin::getIdentity()
+qint64 ChatSDKModulePlugin::getIdentity()
+{
+    return getIdentityInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::getIdentityInContext(qint64 contextHandle)
 {
     qDebug() << "ChatSDKModulePlugin::getIdentity called";
     
-    if (!chatCtx) {
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
         qWarning() << "ChatSDKModulePlugin: Cannot get identity - context not initialized";
-        return false;
+        return 0;
     }
     
-    int result = chat_get_identity(chatCtx, get_identity_callback, this);
+    RequestContext* request = beginRequest(CallbackKind::GetIdentity, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_get_identity(chat->ctx, get_identity_callback, request);
+    });
     
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: Get identity initiated successfully";
-        return true;
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to get identity, error code:" << result;
-        return false;
+        cancelRequest(request);
+        return 0;
     }
 }
 
-bool ChatSDKModulePlugin::createIntroBundle()
+qint64 ChatSDKModulePlugin::createIntroBundle()
+{
+    return createIntroBundleInContext(defaultContextHandle);
+}
+
+qint64 ChatSDKModulePlugin::createIntroBundleInContext(qint64 contextHandle)
 {
     qDebug() << "ChatSDKModulePlugin::createIntroBundle called";
     
-    if (!chatCtx) {
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
         qWarning() << "ChatSDKModulePlugin: Cannot create intro bundle - context not initialized";
-        return false;
+        return 0;
     }
     
-    int result = chat_create_intro_bundle(chatCtx, create_intro_bundle_callback, this);
+    RequestContext* request = beginRequest(CallbackKind::CreateIntroBundle, chat);
+    const qint64 requestId = request->requestId;
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_create_intro_bundle(chat->ctx, create_intro_bundle_callback, request);
+    });
     
     if (result == RET_OK) {
         qDebug() << "ChatSDKModulePlugin: Create intro bundle initiated successfully";
-        return true;
+        return requestId;
     } else {
         qWarning() << "ChatSDKModulePlugin: Failed to create intro bundle, error code:" << result;
+        cancelRequest(request);
+        return 0;
+    }
+}
+
+bool ChatSDKModulePlugin::setIntroBundlePoolSize(int size)
+{
+    qDebug() << "ChatSDKModulePlugin::setIntroBundlePoolSize called with" << size << "bundles";
+
+    if (size < 0) {
+        qWarning() << "ChatSDKModulePlugin: Cannot set intro bundle pool size - size is negative";
         return false;
     }
+
+    introBundlePoolSize = size;
+    for (ChatContext* chat : std::as_const(chatContexts)) {
+        while (chat->introBundles.size() > size) {
+            chat->introBundles.removeLast();
+        }
+        refillIntroBundles(chat);
+    }
+    return true;
+}
+
+QVariantMap ChatSDKModulePlugin::takeIntroBundle()
+{
+    return takeIntroBundleInContext(defaultContextHandle);
+}
+
+QVariantMap ChatSDKModulePlugin::takeIntroBundleInContext(qint64 contextHandle)
+{
+    qDebug() << "ChatSDKModulePlugin::takeIntroBundle called";
+
+    ChatContext* chat = findContext(contextHandle);
+    if (!chat) {
+        qWarning() << "ChatSDKModulePlugin: Cannot take intro bundle - context not initialized";
+        return QVariantMap();
+    }
+
+    QVariantMap result;
+    if (!chat->introBundles.isEmpty()) {
+        ++introBundleHits;
+        result["bundle"] = chat->introBundles.takeFirst();
+        result["requestId"] = qint64(0);
+    } else {
+        ++introBundleMisses;
+        result["bundle"] = QString();
+        result["requestId"] = createIntroBundleInContext(contextHandle);
+    }
+
+    // Top up after the caller has its bundle, not on its path. After a miss
+    // the fallback's completion does it, so no key generation queues behind it.
+    if (result.value("requestId").toLongLong() == 0) {
+        scheduleIntroBundleRefill(contextHandle);
+    }
+    return result;
+}
+
+void ChatSDKModulePlugin::scheduleIntroBundleRefill(qint64 contextHandle)
+{
+    if (introBundlePoolSize == 0) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(this, [this, contextHandle]() {
+        if (ChatContext* chat = findContext(contextHandle)) {
+            refillIntroBundles(chat);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void ChatSDKModulePlugin::refillIntroBundles(ChatContext* chat)
+{
+    if (chat->introBundleRefilling || chat->introBundles.size() >= introBundlePoolSize) {
+        return;
+    }
+
+    const LifecycleState state = chat->state.load(std::memory_order_acquire);
+    if (state != LifecycleState::Initialized && state != LifecycleState::Running) {
+        return;
+    }
+
+    RequestContext* request = beginRequest(CallbackKind::RefillIntroBundle, chat);
+
+    int result = submitRequest(request, [chat, request]() {
+        return chat_create_intro_bundle(chat->ctx, refill_intro_bundle_callback, request);
+    });
+
+    if (result == RET_OK) {
+        chat->introBundleRefilling = true;
+    } else {
+        qWarning() << "ChatSDKModulePlugin: Failed to refill intro bundle pool, error code:" << result;
+        ++introBundleRefillFailures;
+        cancelRequest(request);
+    }
+}
+
+// ============================================================================
+// In-Process Async API
+// ============================================================================
+
+template <typename Result, typename Fill>
+QFuture<Result> ChatSDKModulePlugin::awaitRequest(qint64 requestId, qint64 contextHandle, Fill fill)
+{
+    // Never leave a caller waiting on a request that can no longer complete
+    std::shared_ptr<QFutureInterface<Result>> future(new QFutureInterface<Result>(), [](QFutureInterface<Result>* f) {
+        if (!f->isFinished()) {
+            f->reportCanceled();
+            f->reportFinished();
+        }
+        delete f;
+    });
+    future->reportStarted();
+
+    Resolver resolve = [future, requestId, contextHandle, fill](int callerRet, const QByteArray& payload) {
+        Result result;
+        result.success = callerRet == RET_OK;
+        result.code = callerRet;
+        result.payload = payload;
+        result.requestId = requestId;
+        result.contextHandle = contextHandle;
+        fill(result);
+        future->reportResult(result);
+        future->reportFinished();
+    };
+
+    if (requestId == 0) {
+        resolve(kNoContextError, QByteArray());
+    } else {
+        awaitedRequests.insert(requestId, resolve);
+    }
+    return future->future();
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::startChatAsync()
+{
+    return startChatAsyncInContext(defaultContextHandle);
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::startChatAsyncInContext(qint64 contextHandle)
+{
+    return awaitRequest<ChatSDKResult>(startChatInContext(contextHandle), contextHandle, [](ChatSDKResult&) {});
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::stopChatAsync()
+{
+    return stopChatAsyncInContext(defaultContextHandle);
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::stopChatAsyncInContext(qint64 contextHandle)
+{
+    return awaitRequest<ChatSDKResult>(stopChatInContext(contextHandle), contextHandle, [](ChatSDKResult&) {});
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::getConversationAsync(const QString &convoId)
+{
+    return getConversationAsyncInContext(defaultContextHandle, convoId);
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::getConversationAsyncInContext(qint64 contextHandle, const QString &convoId)
+{
+    return awaitRequest<ChatSDKResult>(getConversationInContext(contextHandle, convoId), contextHandle, [](ChatSDKResult& result) {
+        result.success = result.success && !result.payload.isEmpty();
+    });
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::newPrivateConversationAsync(const QString &introBundleStr, const QByteArray &content)
+{
+    return newPrivateConversationAsyncInContext(defaultContextHandle, introBundleStr, content);
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::newPrivateConversationAsyncInContext(qint64 contextHandle, const QString &introBundleStr, const QByteArray &content)
+{
+    const qint64 requestId = newPrivateConversationBytesInContext(contextHandle, introBundleStr, content);
+    return awaitRequest<ChatSDKResult>(requestId, contextHandle, [](ChatSDKResult& result) {
+        result.success = result.success && !result.payload.isEmpty();
+    });
+}
+
+QFuture<SendResult> ChatSDKModulePlugin::sendMessageAsync(const QString &convoId, const QByteArray &content)
+{
+    return sendMessageAsyncInContext(defaultContextHandle, convoId, content);
+}
+
+QFuture<SendResult> ChatSDKModulePlugin::sendMessageAsyncInContext(qint64 contextHandle, const QString &convoId, const QByteArray &content)
+{
+    const qint64 requestId = sendMessageBytesInContext(contextHandle, convoId, content);
+    return awaitRequest<SendResult>(requestId, contextHandle, [convoId](SendResult& result) {
+        result.convoId = convoId;
+        if (result.success) {
+            result.messageId = extractMessageId(result.payload);
+        }
+    });
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::createIntroBundleAsync()
+{
+    return createIntroBundleAsyncInContext(defaultContextHandle);
+}
+
+QFuture<ChatSDKResult> ChatSDKModulePlugin::createIntroBundleAsyncInContext(qint64 contextHandle)
+{
+    return awaitRequest<ChatSDKResult>(createIntroBundleInContext(contextHandle), contextHandle, [](ChatSDKResult& result) {
+        result.success = result.success && !result.payload.isEmpty();
+    });
 }
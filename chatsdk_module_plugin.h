@@ -1,20 +1,41 @@
 #pragma once
 
+#include <QtCore/QFuture>
+#include <QtCore/QFutureInterface>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
 #include "chatsdk_module_interface.h"
+#include "chatsdk_results.h"
 #include "logos_api.h"
 #include "logos_api_client.h"
 #include "liblogoschat.h"
+#include "conversation_index.h"
+#include "delivery_tracker.h"
+#include "event_queue.h"
+#include "event_subscriptions.h"
+#include "lane_scheduler.h"
+#include "latency_histogram.h"
+#include "outbox.h"
+#include "payload_compressor.h"
+#include "request_pool.h"
+#include "shared_payload_pool.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
 
 /**
  * @class ChatSDKModulePlugin
  * @brief Qt plugin that exposes the Logos Chat SDK.
  *
  * Most operations are asynchronous. For these methods, the call returns
- * immediately — @c true meaning the request was accepted, @c false meaning it
- * was rejected before being sent (e.g. the client has not been initialised yet).
- * The actual result then arrives via the @ref eventResponse signal using a
- * method-specific event name.
+ * immediately with a @c qint64 request ID, or @c 0 if the request was rejected
+ * before being sent (e.g. the client has not been initialised yet). The
+ * actual result then arrives via the @ref eventResponse signal using a
+ * method-specific event name, carrying the same request ID.
  *
  * Some helper operations are synchronous (e.g. @ref initLogos and
  * @ref setEventCallback) and do not emit an @ref eventResponse for completion.
@@ -42,68 +63,116 @@ public:
     /**
      * @brief Initialises the chat client with the provided delivery configuration.
      *
+     * Creates a chat context and makes it the default one that the methods
+     * without a context handle act on (see @ref createChatContext).
+     *
      * @param configJson JSON configuration for the delivery service.
-     * @return @c true if the request was accepted and initialisation was started;
-     *         @c false if initialisation could not start (e.g. invalid config
-     *         preventing context creation). When this function returns @c false,
+     * @return Non-zero request ID if the request was accepted and initialisation
+     *         was started; @c 0 if initialisation could not start (e.g. invalid config
+     *         preventing context creation, or a default context that has not been
+     *         destroyed yet). When this function returns @c 0,
      *         no result signal is emitted and the caller must rely on the return value.
      *
-     * @note If this function returns @c true, the result is returned asynchronously as
+     * @note If this function returns a request ID, the result is returned asynchronously as
      *       @c eventResponse("chatsdkInitResult", data)
      *   - @c data[0] @c bool — @c true on success.
      *   - @c data[1] @c int — status code.
      *   - @c data[2] @c QString — optional message from the SDK.
-     *   - @c data[3] @c QString — ISO-8601 timestamp.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
      */
-    Q_INVOKABLE bool initChat(const QString &configJson) override; // TODO: should not be async
+    Q_INVOKABLE qint64 initChat(const QString &configJson) override; // TODO: should not be async
 
     /**
      * @brief Starts the chat client and connects to the network.
      *
-     * @ref initChat must be called first.
+     * @ref initChat must be called first. Once the client is up, the plugin
+     * seeds its conversation index in the background; that emits no event
+     * (see @ref refreshConversations for an explicit resync).
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not yet initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not yet initialised or already started.
      *
      * @note Asynchronously returns result: @c eventResponse("chatsdkStartResult", data)
      *   - @c data[0] @c bool — @c true on success.
      *   - @c data[1] @c int — status code.
      *   - @c data[2] @c QString — optional message from the SDK.
-     *   - @c data[3] @c QString — ISO-8601 timestamp.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
      */
-    Q_INVOKABLE bool startChat() override;
+    Q_INVOKABLE qint64 startChat() override;
 
     /**
      * @brief Stops the chat client and disconnects from the network.
      *
      * This is only called when deinitializing the chat client. 
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not running.
      *
      * @note Asynchronously returns result: @c eventResponse("chatsdkStopResult", data)
      *   - @c data[0] @c bool — @c true on success.
      *   - @c data[1] @c int — status code.
      *   - @c data[2] @c QString — optional message from the SDK.
-     *   - @c data[3] @c QString — ISO-8601 timestamp.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
      */
-    Q_INVOKABLE bool stopChat() override; // TODO: should not be async
+    Q_INVOKABLE qint64 stopChat() override; // TODO: should not be async
 
     /**
      * @brief Deallocates the chat client.
      *
-     * After this call all memory is freed, and the chat client cannot be used anymore.
-     * Accessing the chat client results in undefined behavior.
+     * The context stops accepting requests as soon as this call returns; every
+     * later call for it returns @c 0 or @c false. Its memory is freed once
+     * liblogoschat has confirmed the destroy and finished all callbacks.
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note  Asynchronously returns result: @c eventResponse("chatsdkDestroyResult", data) — only emitted
      *       when the SDK provides a response message:
      *   - @c data[0] @c QString — message from the SDK.
-     *   - @c data[1] @c QString — ISO-8601 timestamp.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[2] @c qint64 — request ID returned by this call.
+     *   - @c data[3] @c qint64 — handle of the chat context that ran the request.
+     */
+    Q_INVOKABLE qint64 destroyChat() override; // TODO: should not be async
+
+    /**
+     * @brief Brings a client up in one call: init, event callback, then start.
+     *
+     * Runs the sequence of @ref initChat, @ref setEventCallback and
+     * @ref startChat inside the plugin. The event callback is registered as
+     * soon as the context exists, before the client is started, so no push
+     * event is missed. The intermediate @c chatsdkInitResult and
+     * @c chatsdkStartResult events are not emitted; the outcome is reported
+     * once, with a breakdown of where the time went.
+     *
+     * If initialisation or start fails the context is kept, like after a
+     * failed @ref initChat or @ref startChat; call @ref destroyChat to retry.
+     *
+     * @param configJson Same configuration as @ref initChat.
+     * @return Non-zero request ID if the boot was started; @c 0 if a client
+     *         is already initialised or the context could not be created.
+     *
+     * @note  Asynchronously returns result: @c eventResponse("chatsdkBootResult", data)
+     *   - @c data[0] @c bool — @c true if the client is running.
+     *   - @c data[1] @c int — status code of the step that finished the boot.
+     *   - @c data[2] @c QString — message from the SDK for that step.
+     *   - @c data[3] @c QVariantMap — phase timings in microseconds:
+     *     @c "chatNewUs" (@c chat_new until its callback fired),
+     *     @c "callbackWiringUs" (event callback registration),
+     *     @c "startUs" (@c chat_start until its callback fired, @c -1 if
+     *     never submitted) and @c "totalUs"; plus @c "failedPhase"
+     *     (@c QString: @c "chat_new", @c "chat_start" or empty on success).
+     *   - @c data[4] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[5] @c qint64 — request ID returned by this call.
+     *   - @c data[6] @c qint64 — handle of the chat context that was booted.
      */
-    Q_INVOKABLE bool destroyChat() override; // TODO: should not be async
+    Q_INVOKABLE qint64 bootChat(const QString &configJson) override;
 
     /**
      * @brief Subscribes to push events from the SDK.
@@ -120,13 +189,193 @@ public:
      *
      * For all push events @c data is:
      *   - @c data[0] @c QString — JSON payload describing the event.
-     *   - @c data[1] @c QString — ISO-8601 timestamp.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *
+     * @c chatsdkNewMessage additionally carries:
+     *   - @c data[2] @c QByteArray — raw message content, decoded from the
+     *     payload's hex @c "content" field (empty if the field is absent), or
+     *     a shared memory handle or compressed payload for large content (see
+     *     @ref setSharedMemoryThreshold and @ref setPayloadCompression).
+     *
+     * @c chatsdkDeliveryAck additionally carries:
+     *   - @c data[2] @c qint64 — microseconds from submission of the send to
+     *     this acknowledgement, or @c -1 if the message was not tracked (see
+     *     @ref setDeliveryTimeout).
+     *
+     * Every push event ends with the @c qint64 handle of the chat context it
+     * came from (see @ref createChatContext): @c data[2] for
+     * @c chatsdkNewConversation, @c data[3] for the other two.
      *
      * @return @c true if the subscription was registered; @c false if the
      *         client is not initialised.
      */
     Q_INVOKABLE bool setEventCallback() override;
 
+    /**
+     * @brief Switches push event delivery between per-event and coalesced mode.
+     *
+     * By default every push event is emitted as soon as it is delivered, which
+     * gives the lowest latency. With batching enabled, push events are
+     * collected and emitted together once @p maxBatchSize events have
+     * accumulated or @p maxLingerMs milliseconds have passed since the first
+     * event in the batch arrived, whichever comes first:
+     * @c eventResponse("chatsdkEventBatch", data)
+     *   - @c data[0] @c QVariantList — one @c QVariantMap per event, in arrival
+     *     order, with @c "eventName" (@c QString) and @c "data" (@c QVariantList,
+     *     the layout the event would have had on its own).
+     *   - @c data[1] @c int — number of events in the batch.
+     *   - @c data[2] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *
+     * Operation results are never batched. Disabling batching flushes any
+     * events still pending.
+     *
+     * @param enabled      @c true to coalesce push events, @c false for per-event delivery.
+     * @param maxBatchSize Maximum number of events per batch (e.g. 256).
+     * @param maxLingerMs  Maximum time in milliseconds an event waits for its batch (e.g. 2).
+     * @return @c true if the settings were applied; @c false if @p maxBatchSize
+     *         is not positive or @p maxLingerMs is negative.
+     */
+    Q_INVOKABLE bool setEventBatching(bool enabled, int maxBatchSize, int maxLingerMs) override;
+
+    /**
+     * @brief Opts a single event into structured (pre-parsed) payload delivery.
+     *
+     * By default events carry their JSON payload as a @c QString that every
+     * consumer has to parse. With structured delivery enabled for @p eventName,
+     * the plugin parses the payload once and emits it in the same position as
+     * a @c QVariantMap (JSON objects) or @c QVariantList (JSON arrays) whose
+     * keys are the payload's field names. Payloads that fail to parse are still
+     * delivered as the raw @c QString.
+     *
+     * Supported events: @c chatsdkNewMessage, @c chatsdkNewConversation,
+     * @c chatsdkDeliveryAck, @c chatsdkEvent, @c chatsdkListConversationsResult,
+     * @c chatsdkGetConversationResult, @c chatsdkConversationsChunk,
+     * @c chatsdkNewPrivateConversationResult, @c chatsdkSendMessageResult and
+     * @c chatsdkGetIdentityResult.
+     *
+     * @param eventName Event whose payload should be delivered pre-parsed.
+     * @param enabled   @c true for structured delivery, @c false for the raw JSON string.
+     * @return @c true if the setting was applied; @c false if @p eventName
+     *         does not carry a JSON payload.
+     */
+    Q_INVOKABLE bool setStructuredDelivery(const QString &eventName, bool enabled) override;
+
+    /**
+     * @brief Selects the representation of the timestamp carried by every event.
+     *
+     * By default timestamps are @c qint64 steady-clock nanoseconds taken when
+     * the SDK callback fired (@c CLOCK_MONOTONIC on Linux, so comparable across
+     * processes on the same host). Formatting a local-time ISO-8601 string for
+     * every event is comparatively expensive, so it is only produced for
+     * consumers that still expect the previous format.
+     *
+     * @param enabled @c true to emit an ISO-8601 @c QString in the timestamp
+     *                position instead of the @c qint64 nanosecond value.
+     * @return Always @c true.
+     */
+    Q_INVOKABLE bool setIsoTimestamps(bool enabled) override;
+
+    /**
+     * @brief Moves large payloads out of events and into shared memory.
+     *
+     * JSON payloads and raw message content of at least @p thresholdBytes
+     * are copied into a segment from a recycled pool of shared memory
+     * segments, and the event carries a handle instead of the bytes, so they
+     * are not serialised through the IPC link. A handle is a @c QVariantMap
+     * with @c "sharedMemoryKey" (@c QString, for @c QSharedMemory::setKey),
+     * @c "offset" (@c qint64), @c "length" (@c qint64) and @c "slot"
+     * (@c qint64). The payload's position and type otherwise stay the same;
+     * handles take precedence over @ref setStructuredDelivery.
+     *
+     * The consumer attaches to the segment, reads @c "length" bytes at
+     * @c "offset" and then calls @ref releaseSharedPayload with the slot. When
+     * every segment is still held, payloads are sent inline as usual.
+     *
+     * @param thresholdBytes Minimum payload size moved to shared memory;
+     *                       @c 0 (the default) keeps every payload inline.
+     * @return @c true if the setting was applied; @c false if @p thresholdBytes is negative.
+     */
+    Q_INVOKABLE bool setSharedMemoryThreshold(int thresholdBytes) override;
+
+    /**
+     * @brief Returns a shared memory slot to the pool once its payload has been read.
+     *
+     * @param slot @c "slot" of the handle delivered in place of the payload.
+     * @return @c true if the slot was released; @c false if it is unknown or
+     *         was already released.
+     */
+    Q_INVOKABLE bool releaseSharedPayload(qint64 slot) override;
+
+    /**
+     * @brief Compresses large payloads before they are emitted.
+     *
+     * Event JSON is repetitive and compresses well, which pays off when the
+     * consumer sits on another host. JSON payloads and raw message content
+     * of at least @p thresholdBytes are zlib-compressed, and the event
+     * carries a @c QVariantMap in the payload's position with
+     * @c "compressed" (@c QByteArray, in @c qCompress layout), @c "length"
+     * (@c qint64, uncompressed size) and @c "dictionary" (@c bool). Payloads
+     * that would not shrink are sent as usual. Shared memory handles (see
+     * @ref setSharedMemoryThreshold) take precedence over compression, and
+     * compression over @ref setStructuredDelivery.
+     *
+     * When @c "dictionary" is @c false, @c qUncompress restores the payload.
+     * Otherwise the stream was primed with @ref getCompressionDictionary and
+     * the consumer inflates the bytes after the four-byte length with zlib,
+     * supplying that dictionary when @c inflate returns @c Z_NEED_DICT.
+     *
+     * @param thresholdBytes   Minimum payload size compressed; @c 0 (the
+     *                         default) disables compression.
+     * @param primedDictionary Whether to prime every stream with the event
+     *                         JSON dictionary, which lets short payloads
+     *                         shrink too.
+     * @return @c true if the setting was applied; @c false if @p thresholdBytes is negative.
+     */
+    Q_INVOKABLE bool setPayloadCompression(int thresholdBytes, bool primedDictionary) override;
+
+    /**
+     * @brief Returns the preset dictionary used by @ref setPayloadCompression.
+     *
+     * Fixed for a given plugin build; its Adler-32 is the dictionary ID zlib
+     * reports for primed payloads.
+     */
+    Q_INVOKABLE QByteArray getCompressionDictionary() const override;
+
+    /**
+     * @brief Subscribes to an event so that it is emitted.
+     *
+     * Every event is emitted until the first call to @ref subscribe; after
+     * that only subscribed events are. Events without a subscriber are
+     * dropped before their data is built, so they cost nothing to marshal.
+     * Internal bookkeeping such as the conversation index is unaffected.
+     *
+     * @param eventName Event name as listed in @ref eventResponse (e.g.
+     *                  @c "chatsdkNewMessage"), or @c "*" for every event.
+     * @return @c true on success; @c false if @p eventName is not a chatsdk event.
+     */
+    Q_INVOKABLE bool subscribe(const QString &eventName) override;
+
+    /**
+     * @brief Stops emitting an event.
+     *
+     * @param eventName Event name, or @c "*" for every event.
+     * @return @c true on success; @c false if @p eventName is not a chatsdk event.
+     */
+    Q_INVOKABLE bool unsubscribe(const QString &eventName) override;
+
+    /**
+     * @brief Limits conversation push events to a set of conversations.
+     *
+     * Applies to @c chatsdkNewMessage, @c chatsdkNewConversation and
+     * @c chatsdkDeliveryAck; events for other conversations are dropped.
+     * Results of explicit calls are always emitted.
+     *
+     * @param convoIds Conversations to deliver events for; an empty list
+     *                 delivers events for every conversation.
+     * @return Always @c true.
+     */
+    Q_INVOKABLE bool setConversationFilter(const QStringList &convoIds) override;
+
     // -------------------------------------------------------------------------
     // Client Info
     // -------------------------------------------------------------------------
@@ -136,19 +385,21 @@ public:
      * 
      * Ids can be used to uniquely distinguish between client installtions.
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note When the SDK provides a non-empty identifier, this call
      *       asynchronously returns a result via @c eventResponse("chatsdkGetIdResult", data)
      *   - @c data[0] @c QString — the client identifier.
-     *   - @c data[1] @c QString — ISO-8601 timestamp.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[2] @c qint64 — request ID returned by this call.
+     *   - @c data[3] @c qint64 — handle of the chat context that ran the request.
      *
      *       On some failures the SDK may not provide an identifier or message,
      *       and in those cases no @c chatsdkGetIdResult event is emitted. Callers
      *       must not assume that a result signal is always delivered.
      */
-    Q_INVOKABLE bool getId() override; // TODO: should not be async
+    Q_INVOKABLE qint64 getId() override; // TODO: should not be async
 
     // -------------------------------------------------------------------------
     // Conversation Operations
@@ -157,12 +408,17 @@ public:
     /**
      * @brief Retrieves all conversations the local client participates in.
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * The whole list arrives in one event; for accounts with many
+     * conversations prefer @ref streamConversations or @ref listConversationsPage.
+     *
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note Asynchronously returns result (when available): @c eventResponse("chatsdkListConversationsResult", data)
      *   - @c data[0] @c QString — Conversation Ids.
-     *   - @c data[1] @c QString — ISO-8601 timestamp.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[2] @c qint64 — request ID returned by this call.
+     *   - @c data[3] @c qint64 — handle of the chat context that ran the request.
      *
      * @warning Due to current SDK callback semantics, this event is only emitted
      *          when the underlying SDK provides a non-empty list of conversations
@@ -172,20 +428,22 @@ public:
      *          firing; instead, use the synchronous return value from this method
      *          together with appropriate timeout or fallback handling.
      */
-    Q_INVOKABLE bool listConversations() override;  // TODO: should not be async
+    Q_INVOKABLE qint64 listConversations() override;  // TODO: should not be async
 
     /**
      * @brief Retrieves a single conversation by its identifier.
      *
      * This conversation can be used to send messages.
      * @param convoId The conversation identifier to look up.
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note  When the underlying SDK returns a result message, it is delivered
      *        asynchronously as: @c eventResponse("chatsdkGetConversationResult", data)
      *   - @c data[0] @c QString — JSON object describing the conversation.
-     *   - @c data[1] @c QString — ISO-8601 timestamp.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[2] @c qint64 — request ID returned by this call.
+     *   - @c data[3] @c qint64 — handle of the chat context that ran the request.
      *
      * @attention On certain internal failures (for example, if no result message
      *            is produced by the SDK), no @c chatsdkGetConversationResult
@@ -194,7 +452,113 @@ public:
      *            the synchronous return value or their own timeout / error
      *            handling strategy.
      */
-    Q_INVOKABLE bool getConversation(const QString &convoId) override;  // TODO: should not be async
+    Q_INVOKABLE qint64 getConversation(const QString &convoId) override;  // TODO: should not be async
+
+    /**
+     * @brief Re-synchronises the in-plugin conversation index with the SDK.
+     *
+     * The plugin keeps an index of conversations that backs
+     * @ref listConversationsSync and @ref getConversationSync. It is seeded
+     * automatically when @ref startChat succeeds, kept current from push
+     * events and list/get results, and can be rebuilt explicitly with this call.
+     *
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
+     *
+     * @note  Asynchronously returns result: @c eventResponse("chatsdkConversationsRefreshed", data)
+     *   - @c data[0] @c bool — @c true if the index was rebuilt.
+     *   - @c data[1] @c int — number of indexed conversations.
+     *   - @c data[2] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[3] @c qint64 — request ID returned by this call.
+     *   - @c data[4] @c qint64 — handle of the chat context that ran the request.
+     */
+    Q_INVOKABLE qint64 refreshConversations() override;
+
+    /**
+     * @brief Returns every conversation in the in-plugin index.
+     *
+     * Answered synchronously from the index, without a call into the SDK.
+     *
+     * @return One @c QVariantMap per conversation, holding the conversation
+     *         JSON fields as reported by the SDK (at least @c "id"), plus
+     *         @c "lastMessageAt" (ms since epoch) once a message has been seen.
+     */
+    Q_INVOKABLE QVariantList listConversationsSync() const override;
+
+    /**
+     * @brief Looks up a single conversation in the in-plugin index.
+     *
+     * @param convoId The conversation identifier to look up.
+     * @return The conversation as described in @ref listConversationsSync, or
+     *         an empty map if the conversation is not indexed.
+     */
+    Q_INVOKABLE QVariantMap getConversationSync(const QString &convoId) const override;
+
+    /**
+     * @brief Returns one page of the in-plugin conversation index.
+     *
+     * Bounded alternative to @ref listConversationsSync for accounts with many
+     * conversations: each call marshals at most @p limit entries.
+     *
+     * @param cursor Empty for the first page, otherwise @c "nextCursor" of the
+     *               previous page.
+     * @param limit  Maximum number of conversations in the page, at least 1.
+     * @return Map with @c "conversations" (@c QVariantList, entries as in
+     *         @ref listConversationsSync), @c "nextCursor" (@c QString, empty on
+     *         the last page) and @c "total" (@c int, indexed conversations).
+     *         Empty if @p limit is not positive or @p cursor is no longer in the
+     *         index (e.g. after a refresh); restart from an empty cursor then.
+     */
+    Q_INVOKABLE QVariantMap listConversationsPage(const QString &cursor, int limit) const override;
+
+    /**
+     * @brief Returns the conversations that changed since a previous call.
+     *
+     * The conversation index stamps every change (new conversation, new
+     * message, delivery acknowledgement, list or refresh result) with an
+     * increasing version, so polling with the last returned version costs
+     * in proportion to what changed rather than to the number of
+     * conversations. List and refresh results are merged into the index, so
+     * conversations they repeat unchanged are not reported again.
+     *
+     * @param version @c "version" from the previous call, or @c 0 for everything.
+     * @return Map with @c "conversations" (@c QVariantList, entries as in
+     *         @ref listConversationsSync plus @c "version" and, once
+     *         acknowledged, @c "lastDeliveryAckAt"; a conversation that a
+     *         later list no longer contains is reported as @c "id",
+     *         @c "version" and @c "removed" set to @c true), @c "version"
+     *         (@c qint64, pass to the next call) and @c "full" (@c bool).
+     *         @c "full" is @c true for @p version @c 0 and when @p version
+     *         is older than the last 1024 removals the index remembers; the
+     *         list then holds every conversation and replaces the caller's copy.
+     *         Empty if the client is not initialised or @p version is negative.
+     */
+    Q_INVOKABLE QVariantMap listConversationsSince(qint64 version) const override;
+
+    /**
+     * @brief Retrieves all conversations from the SDK, delivered in chunks.
+     *
+     * Like @ref listConversations, but the SDK's result is split on the plugin
+     * side into JSON arrays of at most @p chunkSize conversations, emitted one
+     * per event loop iteration. The first chunk arrives without waiting for the
+     * whole list to be marshalled, and no single event carries the full list.
+     * The conversation index is rebuilt from the chunks as they go out.
+     *
+     * @param chunkSize Maximum number of conversations per chunk, at least 1.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised or @p chunkSize is not positive.
+     *
+     * @note  Asynchronously emits one or more: @c eventResponse("chatsdkConversationsChunk", data)
+     *   - @c data[0] @c bool — @c false if the SDK reported an error; the chunk
+     *     is then empty and the last one.
+     *   - @c data[1] @c QString — JSON array of conversations in this chunk.
+     *   - @c data[2] @c int — chunk index, starting at 0.
+     *   - @c data[3] @c bool — @c true for the last chunk of the list.
+     *   - @c data[4] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[5] @c qint64 — request ID returned by this call.
+     *   - @c data[6] @c qint64 — handle of the chat context that ran the request.
+     */
+    Q_INVOKABLE qint64 streamConversations(int chunkSize) override;
 
     /**
      * @brief Starts a new private (1-to-1) conversation with a remote contact.
@@ -206,32 +570,134 @@ public:
      * @param introBundleStr Introduction bundle of the remote contact.
      * @param contentHex     Hex-encoded content of the opening message
      *                     
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note  Asynchronously returns result: @c eventResponse("chatsdkNewPrivateConversationResult", data)
      *   - @c data[0] @c bool — @c true on success.
      *   - @c data[1] @c int — status code.
      *   - @c data[2] @c QString — JSON object of the newly created conversation.
-     *   - @c data[3] @c QString — ISO-8601 timestamp.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
      */
-    Q_INVOKABLE bool newPrivateConversation(const QString &introBundleStr, const QString &contentHex) override;  // TODO: should not be async
-                                                                                                                 // TODO: content should accept bytes not hex     
+    Q_INVOKABLE qint64 newPrivateConversation(const QString &introBundleStr, const QString &contentHex) override;  // TODO: should not be async
+
+    /**
+     * @brief Binary variant of @ref newPrivateConversation.
+     *
+     * Takes the opening message as raw bytes, so callers neither hex-encode
+     * the payload nor ship it across IPC as a UTF-16 string. The bytes are
+     * hex-encoded exactly once, directly into the buffer handed to liblogoschat.
+     *
+     * @param introBundleStr Introduction bundle of the remote contact.
+     * @param content        Raw content of the opening message.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
+     *
+     * @note  Emits the same @c chatsdkNewPrivateConversationResult event as
+     *        @ref newPrivateConversation.
+     */
+    Q_INVOKABLE qint64 newPrivateConversationBytes(const QString &introBundleStr, const QByteArray &content) override;  // TODO: should not be async
+
     /**
      * @brief Sends a message to an existing conversation.
      *
+     * With an outbox configured (see @ref setOutbox), messages sent while the
+     * client is not running, or rejected by liblogoschat, are queued there
+     * and sent once the client has started; the result event then arrives
+     * with the request ID returned here.
+     *
      * @param convoId    Identifier of the target conversation.
      * @param contentHex Hex-encoded message content.
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note  Asynchronously returns result: @c eventResponse("chatsdkSendMessageResult", data)
      *   - @c data[0] @c bool — @c true on success.
      *   - @c data[1] @c int — status code.
      *   - @c data[2] @c QString — JSON result, may include the assigned message ID.
-     *   - @c data[3] @c QString — ISO-8601 timestamp.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
+     *   - @c data[6] @c QString — hex idempotency key if the message went
+     *     through the outbox (see @ref setOutbox), otherwise empty.
+     */
+    Q_INVOKABLE qint64 sendMessage(const QString &convoId, const QString &contentHex) override;
+
+    /**
+     * @brief Binary variant of @ref sendMessage.
+     *
+     * Takes the message as raw bytes, so callers neither hex-encode the
+     * payload nor ship it across IPC as a UTF-16 string. The bytes are
+     * hex-encoded exactly once, directly into the buffer handed to liblogoschat.
+     *
+     * @param convoId Identifier of the target conversation.
+     * @param content Raw message content.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
+     *
+     * @note  Emits the same @c chatsdkSendMessageResult event as @ref sendMessage.
+     */
+    Q_INVOKABLE qint64 sendMessageBytes(const QString &convoId, const QByteArray &content) override;
+
+    /**
+     * @brief Sends a batch of messages in a single call.
+     *
+     * Every entry is converted up front and the sends are then issued back to
+     * back, so a batch costs one IPC hop instead of one per message.
+     *
+     * @param messages List of entries, each either a @c QVariantMap with
+     *                 @c "convoId" and @c "contentHex" keys or a two-element
+     *                 @c QVariantList @c [convoId, contentHex].
+     * @return Non-zero request ID if the batch was accepted; @c 0 if the client
+     *         is not initialised, the batch is empty or an entry is malformed.
+     *
+     * @note  Once every send has completed, asynchronously returns a single result:
+     *        @c eventResponse("chatsdkSendMessagesResult", data)
+     *   - @c data[0] @c bool — @c true if every message was sent successfully.
+     *   - @c data[1] @c int — number of messages in the batch.
+     *   - @c data[2] @c QVariantList — one @c QVariantMap per entry, in submission order,
+     *     with @c "index" (@c int), @c "success" (@c bool), @c "code" (@c int) and
+     *     @c "result" (@c QString JSON result, may include the assigned message ID).
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
+     *
+     *       Entries the SDK rejects synchronously are reported with their
+     *       error code and an empty result.
      */
-    Q_INVOKABLE bool sendMessage(const QString &convoId, const QString &contentHex) override;   // TODO: content should accept bytes not hex       
+    Q_INVOKABLE qint64 sendMessages(const QVariantList &messages) override;
+
+    /**
+     * @brief Sends the same message to many conversations in a single call.
+     *
+     * The content crosses IPC once and is hex-encoded once into a buffer that
+     * every @c chat_send_message call reads, instead of one encoded copy per
+     * conversation as with repeated @ref sendMessageBytes calls.
+     *
+     * @param convoIds Target conversations.
+     * @param content  Raw message content.
+     * @return Non-zero request ID if the broadcast was accepted; @c 0 if the
+     *         client is not initialised, @p convoIds is empty or contains an
+     *         empty ID.
+     *
+     * @note  Once every send has completed, asynchronously returns a single result:
+     *        @c eventResponse("chatsdkBroadcastMessageResult", data)
+     *   - @c data[0] @c bool — @c true if every send succeeded.
+     *   - @c data[1] @c int — number of target conversations.
+     *   - @c data[2] @c int — number of successful sends.
+     *   - @c data[3] @c QVariantList — one @c QVariantMap per target, in @p convoIds order,
+     *     with @c "convoId" (@c QString), @c "success" (@c bool), @c "code" (@c int),
+     *     @c "result" (@c QString JSON result) and @c "latencyUs" (@c qint64, from
+     *     submission of the broadcast to this send's completion).
+     *   - @c data[4] @c qint64 — microseconds until the last send completed.
+     *   - @c data[5] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[6] @c qint64 — request ID returned by this call.
+     *   - @c data[7] @c qint64 — handle of the chat context that ran the request.
+     */
+    Q_INVOKABLE qint64 broadcastMessage(const QStringList &convoIds, const QByteArray &content) override;
+
     // -------------------------------------------------------------------------
                                                                                               
     // Identity Operations
@@ -240,21 +706,23 @@ public:
     /**
      * @brief Retrieves the local client's identity information.
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note  On success, asynchronously emits: @c eventResponse("chatsdkGetIdentityResult", data)
      *   - @c data[0] @c QString — JSON object containing identity fields.
-     *   - @c data[1] @c QString — ISO-8601 timestamp.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[2] @c qint64 — request ID returned by this call.
+     *   - @c data[3] @c qint64 — handle of the chat context that ran the request.
      *
      * @warning On some failure paths (for example, when no identity data is available
      *          or an internal error occurs in the underlying SDK), no
      *          @c chatsdkGetIdentityResult event may be emitted even if this method
-     *          returned @c true. Callers MUST NOT rely on this event always being
+     *          returned a non-zero request ID. Callers MUST NOT rely on this event always being
      *          delivered and should implement appropriate timeouts or alternative
      *          error handling.
      */
-    Q_INVOKABLE bool getIdentity() override;  // TODO: Deprecate; This should not be used.
+    Q_INVOKABLE qint64 getIdentity() override;  // TODO: Deprecate; This should not be used.
 
     /**
      * @brief Creates a new introduction bundle to share with other users.
@@ -263,16 +731,48 @@ public:
      * initiate a private conversation with you via @ref newPrivateConversation.
      * Share it out-of-band (e.g. via a QR code or copy-paste).
      *
-     * @return @c true if the request was accepted; @c false if the client is
-     *         not initialised.
+     * @return Non-zero request ID if the request was accepted; @c 0 if the
+     *         client is not initialised.
      *
      * @note  Asynchronously returns result: @c eventResponse("chatsdkCreateIntroBundleResult", data)
      *   - @c data[0] @c bool — @c true on success.
      *   - @c data[1] @c int — status code.
      *   - @c data[2] @c QString — the introduction bundle string to share.
-     *   - @c data[3] @c QString — ISO-8601 timestamp.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — request ID returned by this call.
+     *   - @c data[5] @c qint64 — handle of the chat context that ran the request.
+     */
+    Q_INVOKABLE qint64 createIntroBundle() override;  // TODO: should not be async
+
+    /**
+     * @brief Keeps ready-made introduction bundles for @ref takeIntroBundle.
+     *
+     * Every chat context holds up to @p size bundles, created through the
+     * same SDK call as @ref createIntroBundle. The pool is filled once the
+     * client has started and topped up after each handout (after a pool
+     * miss, once the fallback bundle has been delivered), one bundle at a
+     * time so key generation never competes with more than one foreground
+     * request. Refills emit no events.
+     *
+     * @param size Bundles kept per context; @c 0 (the default) disables the
+     *             pool and discards pooled bundles.
+     * @return @c true if the setting was applied; @c false if @p size is negative.
      */
-    Q_INVOKABLE bool createIntroBundle() override;  // TODO: should not be async
+    Q_INVOKABLE bool setIntroBundlePoolSize(int size) override;
+
+    /**
+     * @brief Hands out an introduction bundle from the pool without a round trip.
+     *
+     * Falls back to @ref createIntroBundle when the pool is empty, in which
+     * case the bundle arrives as @c chatsdkCreateIntroBundleResult with the
+     * returned request ID. Each bundle is handed out once.
+     *
+     * @return Map with @c "bundle" (@c QString, empty on a pool miss) and
+     *         @c "requestId" (@c qint64, the fallback request; @c 0 on a hit
+     *         or if the fallback could not be submitted); empty if the
+     *         client is not initialised.
+     */
+    Q_INVOKABLE QVariantMap takeIntroBundle() override;
 
     /** @brief Returns the plugin name. */
     QString name() const override { return "chatsdk_module"; }
@@ -298,6 +798,346 @@ public:
      */
     void emitEvent(const QString& eventName, const QVariantList& data);
 
+    /** Receives every event in place of the LogosAPI client. */
+    using EventSink = std::function<void(const QString& eventName, const QVariantList& data)>;
+
+    /**
+     * @brief Routes events to @p sink instead of the LogosAPI client.
+     *
+     * For in-process hosts and benchmarks that drive the plugin without a
+     * Logos core. Pass an empty function to restore normal routing.
+     */
+    void setEventSink(EventSink sink);
+
+    /**
+     * @brief Reports the state of the queue that hands SDK callbacks to the plugin thread.
+     *
+     * liblogoschat invokes callbacks on its own threads. They only copy the
+     * payload into a bounded lock-free queue; the plugin thread drains it and
+     * emits the events, so the library never blocks on IPC.
+     *
+     * @return Map with the following @c qulonglong entries:
+     *   - @c "capacity" — number of slots in the queue.
+     *   - @c "depth" — callbacks currently waiting to be delivered.
+     *   - @c "enqueued" — callbacks queued since the plugin was created.
+     *   - @c "dropped" — push events discarded because the queue was full.
+     *   - @c "overflowed" — operation results delivered through the slower
+     *     fallback path because the queue was full. Results are never dropped.
+     */
+    Q_INVOKABLE QVariantMap getEventQueueStats() const override;
+
+    /**
+     * @brief Returns latency and throughput metrics for SDK operations and push events.
+     *
+     * Latency is measured from submission of each SDK call to its callback
+     * firing on the library thread. Event rates are computed over the interval
+     * since the previous call to this method (or the previous
+     * @c chatsdkMetrics emission).
+     *
+     * @return Map with:
+     *   - @c "operations" — @c QVariantMap keyed by method name (e.g. @c "sendMessage");
+     *     operations never called are omitted. Each entry holds @c "submitted",
+     *     @c "rejected" (refused synchronously) and @c "completed" counts, an
+     *     @c "errors" map from status code (or @c "other") to count, and
+     *     @c "meanUs", @c "p50Us", @c "p99Us", @c "p999Us", @c "maxUs" latencies
+     *     in microseconds. @c "sendMessages" and @c "broadcastMessage" are
+     *     measured per entry. The index seeding that follows @ref startChat
+     *     is reported as @c "seedConversations".
+     *   - @c "events" — @c QVariantMap keyed by push event name, each with
+     *     @c "count" and @c "perSecond".
+     *   - @c "eventQueue" — see @ref getEventQueueStats.
+     *   - @c "sharedMemory" — shared memory payload pool (see
+     *     @ref setSharedMemoryThreshold): @c "segments", @c "inUse",
+     *     @c "bytes", and @c "stored" / @c "fallbacks" payload counts.
+     *   - @c "compression" — payload compression (see
+     *     @ref setPayloadCompression): @c "compressed" and @c "skipped"
+     *     (did not shrink) payload counts, and @c "bytesIn" / @c "bytesOut"
+     *     of compressed payloads.
+     *   - @c "delivery" — send-to-acknowledgement tracking across all
+     *     contexts: @c "pending", @c "acknowledged" and @c "timedOut" counts
+     *     and the same latency fields as an operation.
+     *   - @c "outbox" — see @ref setOutbox: @c "queued" and @c "drained"
+     *     message counts and @c "pending" across contexts.
+     *   - @c "introBundles" — intro bundle pool (see
+     *     @ref setIntroBundlePoolSize): @c "poolSize", @c "pooled" across
+     *     contexts, @c "hits" and @c "misses" of @ref takeIntroBundle, and
+     *     @c "refilled" / @c "refillFailures" counts. Refill latency is
+     *     reported under @c "operations" as @c "refillIntroBundle".
+     *   - @c "lanes" — priority lanes (see @ref setPriorityLanes):
+     *     @c "maxInFlight", and per lane name a @c QVariantMap with
+     *     @c "weight", @c "held" and @c "inFlight" calls across contexts,
+     *     @c "maxHeld", @c "calls" issued, how many of them were
+     *     @c "delayed", and the same latency fields as an operation,
+     *     measuring each call's wait from the request to the SDK call.
+     *   - @c "intervalSec" — length of the rate interval in seconds.
+     */
+    Q_INVOKABLE QVariantMap getMetrics() override;
+
+    /**
+     * @brief Emits @ref getMetrics periodically for scraping.
+     *
+     * @param intervalMs Emission period in milliseconds; @c 0 stops emission.
+     * @return @c true if the setting was applied; @c false if @p intervalMs is negative.
+     *
+     * @note  Emits every @p intervalMs: @c eventResponse("chatsdkMetrics", data)
+     *   - @c data[0] @c QVariantMap — the result of @ref getMetrics.
+     *   - @c data[1] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     */
+    Q_INVOKABLE bool setMetricsInterval(int intervalMs) override;
+
+    /**
+     * @brief Sets how long a sent message may wait for its delivery acknowledgement.
+     *
+     * Every successful send whose result carries a message ID is tracked
+     * until the matching @c chatsdkDeliveryAck arrives. Acknowledgements feed
+     * the @c "delivery" latency in @ref getMetrics; messages still
+     * unacknowledged when the deadline passes are reported once and dropped.
+     * Defaults to 30 seconds.
+     *
+     * @param timeoutMs Deadline in milliseconds, measured from submission of
+     *                  the send; @c 0 turns tracking off and forgets every
+     *                  tracked message.
+     * @return @c true if the setting was applied; @c false if @p timeoutMs is negative.
+     *
+     * @note  For every overdue message emits: @c eventResponse("chatsdkDeliveryTimeout", data)
+     *   - @c data[0] @c QString — message ID.
+     *   - @c data[1] @c QString — conversation ID.
+     *   - @c data[2] @c qint64 — milliseconds since the send was submitted.
+     *   - @c data[3] @c qint64 — timestamp (see @ref setIsoTimestamps).
+     *   - @c data[4] @c qint64 — handle of the chat context that sent the message.
+     *
+     *       Like other push events it honours @ref setConversationFilter and
+     *       is coalesced by @ref setEventBatching.
+     */
+    Q_INVOKABLE bool setDeliveryTimeout(int timeoutMs) override;
+
+    /**
+     * @brief Returns the messages still awaiting a delivery acknowledgement.
+     *
+     * @return Map with @c "pending" (@c int, total) and
+     *         @c "pendingByConversation" (@c QVariantMap from conversation ID
+     *         to @c int); empty if the client is not initialised.
+     */
+    Q_INVOKABLE QVariantMap getPendingDeliveries() const override;
+
+    /**
+     * @brief Keeps unsent messages in a durable outbox instead of failing them.
+     *
+     * Opens (or creates) an append-only log at @p path, memory-mapped and
+     * flushed to disk in batches every few milliseconds. @ref sendMessage and
+     * @ref sendMessageBytes then queue messages there while the client is
+     * not running, while earlier messages are still queued (so order is
+     * kept), or when liblogoschat rejects the submission, including one
+     * held in a priority lane (see @ref setPriorityLanes). Errors reported by
+     * the send callback are delivered as usual and not retried.
+     *
+     * Queued messages are drained once @c chat_start succeeds, with a bounded
+     * number of sends in flight. Each message carries an idempotency key and
+     * is submitted at most once per run; it is marked done when its callback
+     * arrives. Opening a log left by an earlier run restores every message
+     * not marked done, so those are drained too; a crash between a send and
+     * the next flush can repeat that send. The key is reported with every
+     * @c chatsdkSendMessageResult of a queued message and stays the same
+     * across runs, so a caller that records the keys it has seen succeed can
+     * recognise such a repeat. liblogoschat takes no key, so recipients
+     * cannot.
+     *
+     * @param path Log file; an empty path closes the outbox and keeps any
+     *             queued messages on disk for a later run.
+     * @return @c true if the outbox was opened or closed; @c false if the
+     *         client is not initialised or the file could not be opened.
+     */
+    Q_INVOKABLE bool setOutbox(const QString &path) override;
+
+    /**
+     * @brief Returns the messages waiting in the outbox.
+     *
+     * @return Map with @c "path", @c "pending", @c "inFlight", the log's
+     *         @c "logBytes" / @c "fileBytes" / @c "syncs", and @c "entries",
+     *         one @c QVariantMap per queued message in send order with
+     *         @c "key" (@c QString, hex idempotency key), @c "convoId",
+     *         @c "queuedAt" (ms since epoch), @c "requestId" (@c 0 for
+     *         messages restored from an earlier run) and @c "inFlight";
+     *         empty if the client is not initialised or has no outbox.
+     */
+    Q_INVOKABLE QVariantMap getOutbox() const override;
+
+    // -------------------------------------------------------------------------
+    // Priority Lanes
+    // -------------------------------------------------------------------------
+    //
+    // liblogoschat works through the calls it is given in order. With lanes
+    // enabled the plugin keeps only a bounded number of calls outstanding per
+    // context and holds the rest in three lanes, @c "control",
+    // @c "interactive" and @c "bulk", issuing them by weighted fair queueing
+    // as earlier calls complete. A query made during a send flood then waits
+    // for a few slots instead of the whole flood.
+    //
+    // Every operation has a lane; by default @ref startChat and @ref stopChat
+    // are control, queries, @ref newPrivateConversation and
+    // @ref createIntroBundle are interactive, and sends, conversation
+    // refreshes, seeding and streams, outbox drains and intro bundle refills
+    // are bulk.
+    // @ref initChat and @ref destroyChat are never held.
+
+    /**
+     * @brief Turns priority lanes on or off and sets their weights.
+     *
+     * While a lane is backlogged, each lane is given slots in proportion to
+     * its weight among the lanes that have calls waiting.
+     *
+     * A held call has already returned its request ID. If liblogoschat
+     * rejects it when it is finally issued, or the context is destroyed
+     * first, its result event reports the failure with the rejecting status
+     * code (@c -1 if it was never issued). @ref sendMessages and
+     * @ref broadcastMessage report it in the failed entry's status.
+     *
+     * @param maxInFlight       Calls each context keeps outstanding in
+     *                          liblogoschat; @c 0 (the default) issues every
+     *                          call immediately.
+     * @param controlWeight     Share of the @c "control" lane, 1 to 1000. Default 8.
+     * @param interactiveWeight Share of the @c "interactive" lane, 1 to 1000. Default 4.
+     * @param bulkWeight        Share of the @c "bulk" lane, 1 to 1000. Default 1.
+     * @return @c true if applied; @c false if @p maxInFlight is negative or a
+     *         weight is out of range.
+     */
+    Q_INVOKABLE bool setPriorityLanes(int maxInFlight, int controlWeight, int interactiveWeight, int bulkWeight) override;
+
+    /**
+     * @brief Sets the lane later calls of an operation are queued in.
+     *
+     * @param operation Method name as reported by @ref getMetrics, e.g.
+     *                  @c "sendMessage" or @c "getConversation";
+     *                  @c "sendMessageBytes" and
+     *                  @c "newPrivateConversationBytes" share the entry of
+     *                  their hex counterparts.
+     * @param lane      @c "control", @c "interactive" or @c "bulk".
+     * @return @c true if applied; @c false if the operation is unknown or
+     *         never held (@c "initChat", @c "destroyChat"), or the lane is unknown.
+     */
+    Q_INVOKABLE bool setOperationLane(const QString &operation, const QString &lane) override;
+
+    /**
+     * @brief Moves a request that is still held to another lane.
+     *
+     * Lets a caller promote one call out of a backlog, e.g. a message the
+     * user just typed that is stuck behind a bot's sends. It joins the back
+     * of its new lane. All held entries of a @ref sendMessages or
+     * @ref broadcastMessage request move together.
+     *
+     * @param requestId ID returned by the operation.
+     * @param lane      @c "control", @c "interactive" or @c "bulk".
+     * @return @c true if the request is held in @p lane now; @c false if it
+     *         was already issued or the lane is unknown.
+     */
+    Q_INVOKABLE bool setRequestLane(qint64 requestId, const QString &lane) override;
+
+    // -------------------------------------------------------------------------
+    // Multiple Chat Contexts
+    // -------------------------------------------------------------------------
+    //
+    // One plugin instance can host many chat identities, each with its own
+    // liblogoschat context and conversation index, addressed by a context
+    // handle. The methods above act on the default context created by
+    // initChat; each has an @c ...InContext counterpart below taking the
+    // handle as its first argument, with the same result events.
+
+    /**
+     * @brief Creates an additional chat context without making it the default.
+     *
+     * @param configJson JSON configuration for the delivery service.
+     * @return Non-zero context handle; @c 0 if the context could not be created.
+     *
+     * @note  Emits @c chatsdkInitResult like @ref initChat; match it on the
+     *        context handle, which is its last element.
+     */
+    Q_INVOKABLE qint64 createChatContext(const QString &configJson) override;
+
+    /**
+     * @brief Lists the live chat contexts.
+     *
+     * @return One @c QVariantMap per context, ordered by handle, with
+     *         @c "handle" (@c qint64), @c "shard" (@c int), @c "default"
+     *         (@c bool), @c "state" (@c QString: @c "initialized",
+     *         @c "running" or @c "stopping"), @c "pendingCallbacks" (@c int,
+     *         SDK callbacks still outstanding), @c "conversations"
+     *         (@c int, indexed conversations), @c "introBundles" (@c int,
+     *         pooled) and @c "heldCalls" (@c int, calls waiting in a
+     *         priority lane).
+     */
+    Q_INVOKABLE QVariantList listChatContexts() const override;
+
+    /**
+     * @brief Sets how many callback queues contexts are spread over.
+     *
+     * Each shard has its own bounded callback queue, and contexts are assigned
+     * to shards round-robin as they are created. The plugin thread drains the
+     * shards in turn, a bounded number of callbacks at a time. A context that
+     * floods its queue therefore only drops its own shard's events and cannot
+     * delay results for contexts on other shards.
+     *
+     * @param shards Number of shards, 1 to 64. Defaults to 1.
+     * @return @c true if applied; @c false if out of range or if any chat
+     *         context exists.
+     */
+    Q_INVOKABLE bool setContextShards(int shards) override;
+
+    Q_INVOKABLE qint64 startChatInContext(qint64 contextHandle) override;
+    Q_INVOKABLE qint64 stopChatInContext(qint64 contextHandle) override;
+    Q_INVOKABLE qint64 destroyChatInContext(qint64 contextHandle) override;
+    Q_INVOKABLE bool setEventCallbackInContext(qint64 contextHandle) override;
+    Q_INVOKABLE qint64 getIdInContext(qint64 contextHandle) override;
+    Q_INVOKABLE qint64 listConversationsInContext(qint64 contextHandle) override;
+    Q_INVOKABLE qint64 getConversationInContext(qint64 contextHandle, const QString &convoId) override;
+    Q_INVOKABLE qint64 refreshConversationsInContext(qint64 contextHandle) override;
+    Q_INVOKABLE QVariantList listConversationsSyncInContext(qint64 contextHandle) const override;
+    Q_INVOKABLE QVariantMap getConversationSyncInContext(qint64 contextHandle, const QString &convoId) const override;
+    Q_INVOKABLE QVariantMap listConversationsPageInContext(qint64 contextHandle, const QString &cursor, int limit) const override;
+    Q_INVOKABLE QVariantMap listConversationsSinceInContext(qint64 contextHandle, qint64 version) const override;
+    Q_INVOKABLE QVariantMap getPendingDeliveriesInContext(qint64 contextHandle) const override;
+    Q_INVOKABLE bool setOutboxInContext(qint64 contextHandle, const QString &path) override;
+    Q_INVOKABLE QVariantMap getOutboxInContext(qint64 contextHandle) const override;
+    Q_INVOKABLE qint64 streamConversationsInContext(qint64 contextHandle, int chunkSize) override;
+    Q_INVOKABLE qint64 newPrivateConversationInContext(qint64 contextHandle, const QString &introBundleStr, const QString &contentHex) override;
+    Q_INVOKABLE qint64 newPrivateConversationBytesInContext(qint64 contextHandle, const QString &introBundleStr, const QByteArray &content) override;
+    Q_INVOKABLE qint64 sendMessageInContext(qint64 contextHandle, const QString &convoId, const QString &contentHex) override;
+    Q_INVOKABLE qint64 sendMessageBytesInContext(qint64 contextHandle, const QString &convoId, const QByteArray &content) override;
+    Q_INVOKABLE qint64 sendMessagesInContext(qint64 contextHandle, const QVariantList &messages) override;
+    Q_INVOKABLE qint64 broadcastMessageInContext(qint64 contextHandle, const QStringList &convoIds, const QByteArray &content) override;
+    Q_INVOKABLE qint64 getIdentityInContext(qint64 contextHandle) override;
+    Q_INVOKABLE qint64 createIntroBundleInContext(qint64 contextHandle) override;
+    Q_INVOKABLE QVariantMap takeIntroBundleInContext(qint64 contextHandle) override;
+
+    // -------------------------------------------------------------------------
+    // In-Process Async API
+    // -------------------------------------------------------------------------
+    //
+    // For callers that link the plugin directly. Each method submits the
+    // same request as its Q_INVOKABLE counterpart and returns a future that
+    // resolves on the plugin thread once the SDK callback has been
+    // delivered, after the plugin's own bookkeeping (lifecycle state,
+    // conversation index, delivery tracking) is up to date. The operation's
+    // result event is not emitted for these requests.
+    //
+    // A request rejected synchronously resolves at once with @c requestId 0
+    // and @c code -1. Futures still pending when the plugin is destroyed are
+    // cancelled. The plugin thread must not block on a future; use a
+    // QFutureWatcher or a continuation instead.
+
+    QFuture<ChatSDKResult> startChatAsync();
+    QFuture<ChatSDKResult> stopChatAsync();
+    QFuture<ChatSDKResult> getConversationAsync(const QString &convoId);
+    QFuture<ChatSDKResult> newPrivateConversationAsync(const QString &introBundleStr, const QByteArray &content);
+    QFuture<SendResult> sendMessageAsync(const QString &convoId, const QByteArray &content);
+    QFuture<ChatSDKResult> createIntroBundleAsync();
+
+    QFuture<ChatSDKResult> startChatAsyncInContext(qint64 contextHandle);
+    QFuture<ChatSDKResult> stopChatAsyncInContext(qint64 contextHandle);
+    QFuture<ChatSDKResult> getConversationAsyncInContext(qint64 contextHandle, const QString &convoId);
+    QFuture<ChatSDKResult> newPrivateConversationAsyncInContext(qint64 contextHandle, const QString &introBundleStr, const QByteArray &content);
+    QFuture<SendResult> sendMessageAsyncInContext(qint64 contextHandle, const QString &convoId, const QByteArray &content);
+    QFuture<ChatSDKResult> createIntroBundleAsyncInContext(qint64 contextHandle);
+
 signals:
     /**
      * @brief Emitted when the SDK completes an operation or delivers a push event.
@@ -306,41 +1146,76 @@ signals:
      * to identify which operation completed. See each method's @c @note for the
      * exact @p data layout.
      *
+     * Operation results additionally carry the @c qint64 request ID returned
+     * by the call that produced them, so callers can keep many requests of the
+     * same type in flight, followed by the @c qint64 handle of the chat context
+     * they ran on as their last element. Push events also end with the handle
+     * of the context that received them.
+     *
+     * Only events passing @ref subscribe and @ref setConversationFilter are
+     * emitted; by default that is all of them.
+     *
+     * Timestamps are @c qint64 monotonic nanoseconds, or ISO-8601 @c QString
+     * values once @ref setIsoTimestamps is enabled.
+     *
+     * Events opted into @ref setStructuredDelivery carry a @c QVariantMap or
+     * @c QVariantList in place of the JSON @c QString listed below.
+     *
      * **Event reference:**
      *
      * *Lifecycle*
      * | Event | data[0] | data[1] | data[2] | data[3] |
      * |---|---|---|---|---|
-     * | @c chatsdkInitResult       | `bool` success | `int` status code | `QString` SDK message | `QString` ISO-8601 timestamp |
-     * | @c chatsdkStartResult      | `bool` success | `int` status code | `QString` SDK message | `QString` ISO-8601 timestamp |
-     * | @c chatsdkStopResult       | `bool` success | `int` status code | `QString` SDK message | `QString` ISO-8601 timestamp |
-     * | @c chatsdkDestroyResult    | `QString` SDK message | `QString` ISO-8601 timestamp | — | — |
+     * | @c chatsdkInitResult       | `bool` success | `int` status code | `QString` SDK message | `qint64` timestamp |
+     * | @c chatsdkStartResult      | `bool` success | `int` status code | `QString` SDK message | `qint64` timestamp |
+     * | @c chatsdkStopResult       | `bool` success | `int` status code | `QString` SDK message | `qint64` timestamp |
+     * | @c chatsdkDestroyResult    | `QString` SDK message | `qint64` timestamp | — | — |
+     * | @c chatsdkBootResult       | `bool` success | `int` status code | `QString` SDK message | `QVariantMap` phase timings |
      *
      * *Client info*
      * | Event | data[0] | data[1] |
      * |---|---|---|
-     * | @c chatsdkGetIdResult | `QString` client identifier | `QString` ISO-8601 timestamp |
+     * | @c chatsdkGetIdResult | `QString` client identifier | `qint64` timestamp |
      *
      * *Conversations*
      * | Event | data[0] | data[1] | data[2] | data[3] |
      * |---|---|---|---|---|
-     * | @c chatsdkListConversationsResult        | `QString` conversation IDs | `QString` ISO-8601 timestamp | — | — |
-     * | @c chatsdkGetConversationResult          | `QString` JSON conversation object | `QString` ISO-8601 timestamp | — | — |
-     * | @c chatsdkNewPrivateConversationResult   | `bool` success | `int` status code | `QString` JSON conversation object | `QString` ISO-8601 timestamp |
-     * | @c chatsdkSendMessageResult              | `bool` success | `int` status code | `QString` JSON result (may include message ID) | `QString` ISO-8601 timestamp |
+     * | @c chatsdkListConversationsResult        | `QString` conversation IDs | `qint64` timestamp | — | — |
+     * | @c chatsdkGetConversationResult          | `QString` JSON conversation object | `qint64` timestamp | — | — |
+     * | @c chatsdkConversationsRefreshed         | `bool` success | `int` indexed conversations | `qint64` timestamp | — |
+     * | @c chatsdkConversationsChunk             | `bool` success | `QString` JSON array of conversations | `int` chunk index | `bool` last chunk |
+     * | @c chatsdkNewPrivateConversationResult   | `bool` success | `int` status code | `QString` JSON conversation object | `qint64` timestamp |
+     * | @c chatsdkSendMessageResult              | `bool` success | `int` status code | `QString` JSON result (may include message ID) | `qint64` timestamp |
+     * | @c chatsdkSendMessagesResult             | `bool` all succeeded | `int` batch size | `QVariantList` per-entry status maps | `qint64` timestamp |
+     * | @c chatsdkBroadcastMessageResult         | `bool` all succeeded | `int` target count | `int` successful sends | `QVariantList` per-target status maps |
      *
      * *Identity*
      * | Event | data[0] | data[1] | data[2] | data[3] |
      * |---|---|---|---|---|
-     * | @c chatsdkGetIdentityResult        | `QString` JSON identity object | `QString` ISO-8601 timestamp | — | — |
-     * | @c chatsdkCreateIntroBundleResult  | `bool` success | `int` status code | `QString` introduction bundle string | `QString` ISO-8601 timestamp |
+     * | @c chatsdkGetIdentityResult        | `QString` JSON identity object | `qint64` timestamp | — | — |
+     * | @c chatsdkCreateIntroBundleResult  | `bool` success | `int` status code | `QString` introduction bundle string | `qint64` timestamp |
      *
      * *Push events (via @ref setEventCallback)*
+     * | Event | data[0] | data[1] | data[2] | data[3] |
+     * |---|---|---|---|---|
+     * | @c chatsdkNewMessage      | `QString` JSON payload | `qint64` timestamp | `QByteArray` raw message content | `qint64` context handle |
+     * | @c chatsdkNewConversation | `QString` JSON payload | `qint64` timestamp | `qint64` context handle | — |
+     * | @c chatsdkDeliveryAck     | `QString` JSON payload | `qint64` timestamp | `qint64` send-to-ack latency (us) | `qint64` context handle |
+     *
+     * *Coalesced push events (via @ref setEventBatching)*
+     * | Event | data[0] | data[1] | data[2] |
+     * |---|---|---|---|
+     * | @c chatsdkEventBatch | `QVariantList` of `{eventName, data}` maps | `int` event count | `qint64` timestamp |
+     *
+     * *Diagnostics (via @ref setMetricsInterval)*
      * | Event | data[0] | data[1] |
      * |---|---|---|
-     * | @c chatsdkNewMessage      | `QString` JSON payload | `QString` ISO-8601 timestamp |
-     * | @c chatsdkNewConversation | `QString` JSON payload | `QString` ISO-8601 timestamp |
-     * | @c chatsdkDeliveryAck     | `QString` JSON payload | `QString` ISO-8601 timestamp |
+     * | @c chatsdkMetrics | `QVariantMap` metrics snapshot | `qint64` timestamp |
+     *
+     * *Delivery tracking (via @ref setDeliveryTimeout)*
+     * | Event | data[0] | data[1] | data[2] | data[3] | data[4] |
+     * |---|---|---|---|---|---|
+     * | @c chatsdkDeliveryTimeout | `QString` message ID | `QString` conversation ID | `qint64` ms since send | `qint64` timestamp | `qint64` context handle |
      *
      * @param eventName Name identifying the event type.
      * @param data      Ordered list of event-specific arguments.
@@ -348,7 +1223,279 @@ signals:
     void eventResponse(const QString& eventName, const QVariantList& data);  // TODO: should split into dedicated signals per event.     
 
 private:
-    void* chatCtx;
+    struct SendBatch;
+
+    /**
+     * Lifecycle of a @ref ChatContext:
+     * Uninit -> Initialized -> Running -> Stopping -> Initialized ... -> Destroyed.
+     * Destroyed can be entered from any other state and is final.
+     */
+    enum class LifecycleState {
+        Uninit,         // chat_new has not returned yet
+        Initialized,    // context created, client not started
+        Running,        // start submitted or confirmed
+        Stopping,       // stop submitted, not yet confirmed
+        Destroyed       // destroy submitted; no new requests
+    };
+
+    /** Progress of a @ref bootChat sequence; @c requestId is 0 when none is running. */
+    struct BootProgress {
+        qint64 requestId = 0;
+        qint64 initRequestId = 0;
+        qint64 startRequestId = 0;
+        qint64 startedAtNs = 0;         // steady clock, bootChat entry
+        qint64 wiringNs = 0;
+        qint64 initAtNs = 0;            // init callback fired
+        qint64 startSubmittedAtNs = 0;  // chat_start issued; filled in when its result arrives
+    };
+
+    /**
+     * One hosted chat identity. Handed to liblogoschat as the event callback's
+     * @c userData, so @c plugin, @c handle and @c shard never change after
+     * creation. The lifecycle state and callback counters are atomics read by
+     * library threads; everything else is only touched on the plugin thread.
+     *
+     * Callbacks mark themselves in @c activeCallbacks before looking at
+     * @c detached, and teardown sets @c detached before waiting for
+     * @c activeCallbacks to drain, so no callback can reach a plugin that is
+     * being destroyed.
+     */
+    struct ChatContext {
+        ChatSDKModulePlugin* plugin = nullptr;
+        qint64 handle = 0;
+        int shard = 0;
+        void* ctx = nullptr;
+        ConversationIndex conversationIndex;
+        DeliveryTracker deliveries;
+        LaneScheduler lanes;                    // calls held back by the in-flight window
+        QStringList introBundles;               // pooled, oldest first
+        BootProgress boot;
+        std::unique_ptr<Outbox> outbox;
+        bool introBundleRefilling = false;      // one refill in flight at most
+        bool destroyConfirmed = false;          // freed by reapContexts once idle
+
+        std::atomic<LifecycleState> state{LifecycleState::Uninit};
+        std::atomic<int> pendingCallbacks{0};   // request callbacks liblogoschat still owes
+        std::atomic<int> activeCallbacks{0};    // callbacks running on library threads right now
+        std::atomic<bool> detached{false};      // plugin gone; callbacks return immediately
+
+        bool acceptsRequests() const
+        {
+            const LifecycleState current = state.load(std::memory_order_acquire);
+            return current != LifecycleState::Uninit && current != LifecycleState::Destroyed;
+        }
+
+        bool advance(LifecycleState from, LifecycleState to)
+        {
+            return state.compare_exchange_strong(from, to, std::memory_order_acq_rel);
+        }
+
+        bool idle() const { return pendingCallbacks.load() == 0 && activeCallbacks.load() == 0; }
+    };
+
+    /** Identifies which SDK callback produced a @ref PendingCallback. */
+    enum class CallbackKind {
+        Init,
+        Start,
+        Stop,
+        Destroy,
+        Event,
+        GetId,
+        ListConversations,
+        RefreshConversations,
+        StreamConversations,
+        GetConversation,
+        NewPrivateConversation,
+        SendMessage,
+        SendBatchItem,
+        BroadcastItem,
+        GetIdentity,
+        CreateIntroBundle,
+        RefillIntroBundle,
+        SeedConversations
+    };
+    static constexpr size_t kCallbackKindCount = static_cast<size_t>(CallbackKind::SeedConversations) + 1;
+
+    /** Counters and latency histogram for one kind of SDK call; updated lock-free. */
+    struct OperationMetrics {
+        std::atomic<quint64> submitted{0};
+        std::atomic<quint64> rejected{0};
+        std::array<std::atomic<quint64>, 8> errorCodes{};   // by status code; last slot counts all others
+        LatencyHistogram latency;
+
+        void countError(int code)
+        {
+            const size_t slot = (code >= 0 && static_cast<size_t>(code) < errorCodes.size() - 1)
+                                    ? static_cast<size_t>(code) : errorCodes.size() - 1;
+            errorCodes[slot].fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Per-call state passed to liblogoschat as @c userData. Pooled and
+     * recycled once the call's result has been delivered.
+     */
+    struct RequestContext {
+        ChatSDKModulePlugin* plugin = nullptr;
+        ChatContext* chat = nullptr;
+        qint64 requestId = 0;
+        qint64 contextHandle = 0;
+        int shard = 0;
+        CallbackKind kind = CallbackKind::Init;
+        qint64 submittedAtNs = 0;    // steady clock, for per-call latency
+        int chunkSize = 0;           // streamConversations only
+        QString convoId;             // sendMessage only, for delivery tracking
+        quint64 outboxKey = 0;       // sendMessage drained from the outbox
+        int lane = -1;               // lane whose in-flight slot the call holds; -1 if none
+    };
+
+    /** Wait counters for one priority lane, across contexts. */
+    struct LaneMetrics {
+        quint64 delayed = 0;         // calls that had to wait for a slot
+        int maxHeld = 0;
+        LatencyHistogram wait;       // request to SDK call, including calls that did not wait
+    };
+
+    /** A streamed list-conversations result, emitted one chunk per event loop iteration. */
+    struct ConversationStream {
+        QByteArray payload;
+        size_t pos = 0;              // scan position inside the conversation array
+        int chunkSize = 0;
+        int chunkIndex = 0;
+        bool failed = false;         // emitted as a single empty last chunk
+        QVariant timestamp;
+        qint64 requestId = 0;
+        qint64 contextHandle = 0;
+    };
+
+    /** A callback invocation copied off the library thread, waiting for delivery. */
+    struct PendingCallback {
+        CallbackKind kind = CallbackKind::Event;
+        int callerRet = RET_OK;
+        QByteArray payload;
+        void* context = nullptr;     // RequestContext, SendBatch::Item for batch entries, ChatContext for events
+        qint64 contextHandle = 0;
+        qint64 receivedAtNs = 0;     // steady-clock time the callback fired
+        qint64 receivedAtMs = 0;     // wall-clock time the callback fired
+    };
+
+    ChatContext* findContext(qint64 contextHandle) const;
+    qint64 createContext(const QString &configJson, qint64 &requestId);
+    void reapContexts();
+    bool detachContexts();
+    static const char* lifecycleStateName(LifecycleState state);
+
+    RequestContext* beginRequest(CallbackKind kind, ChatContext* chat, qint64 requestId = 0);
+    qint64 submitBatch(SendBatch* batch, ChatContext* chat, CallbackKind kind);
+    void cancelRequest(RequestContext* request);
+    template <typename Submit>
+    int submitRequest(RequestContext* request, Submit submit);
+    template <typename Submit, typename Reject>
+    int submitRequest(RequestContext* request, int lane, Submit submit, Reject reject);
+    template <typename Submit, typename Reject>
+    int scheduleCall(ChatContext* chat, int lane, qint64 requestId, Submit submit, Reject reject);
+    void pumpLanes(ChatContext* chat);
+    void rejectRequest(RequestContext* request, int result);
+    void rejectHeldCalls(ChatContext* chat);
+
+    static const char* operationName(CallbackKind kind);
+    static int defaultLane(CallbackKind kind);
+    void recordSubmission(CallbackKind kind, int result);
+    void recordCompletion(CallbackKind kind, int callerRet, qint64 latencyNs);
+    void emitMetrics();
+
+    void enqueueCallback(CallbackKind kind, int callerRet, const char* msg, size_t len, void* context);
+    void drainCallbacks();
+    void deliverCallback(PendingCallback& pending);
+    void emitEvent(ChatSDKEvent event, const QVariantList& data);
+    QVariant jsonPayload(ChatSDKEvent event, const QByteArray& payload);
+    QVariant rawPayload(const QByteArray& bytes);
+    QVariant sharedPayload(const QByteArray& bytes);
+    QVariant compressedPayload(const QByteArray& bytes);
+    void emitPushEvent(ChatSDKEvent event, const QVariantList& data);
+    QVariant eventTimestamp(qint64 monotonicNs, qint64 wallClockMs) const;
+    QVariant currentTimestamp() const;
+    void flushEventBatch();
+    void emitConversationChunk(const std::shared_ptr<ConversationStream>& stream);
+    void trackDelivery(ChatContext* chat, const QByteArray& result, const QString& convoId, qint64 sentAtNs);
+    qint64 acknowledgeDelivery(ChatContext* chat, const QByteArray& ack, qint64 ackAtNs);
+    void checkDeliveryTimeouts();
+    void refillIntroBundles(ChatContext* chat);
+    void seedConversations(ChatContext* chat);
+    qint64 submitMessage(ChatContext* chat, const QString& convoId, const QByteArray& contentHex);
+    qint64 queueInOutbox(ChatContext* chat, const QString& convoId, const QByteArray& contentHex, qint64 requestId = 0);
+    void drainOutbox(ChatContext* chat);
+    void syncOutboxes();
+    template <typename Result, typename Fill>
+    QFuture<Result> awaitRequest(qint64 requestId, qint64 contextHandle, Fill fill);
+    void continueBoot(ChatContext* chat, int callerRet, const QByteArray& payload, qint64 initAtNs, const QVariant& timestamp);
+    void finishBoot(ChatContext* chat, int callerRet, const QByteArray& payload, qint64 finishedAtNs, const QVariant& timestamp);
+    void scheduleIntroBundleRefill(qint64 contextHandle);
+
+    QHash<qint64, ChatContext*> chatContexts;
+    QHash<qint64, ChatContext*> retiredContexts;   // destroy requested, not yet freed
+    QTimer reapTimer;
+    qint64 lastContextHandle = 0;
+    qint64 defaultContextHandle = 0;
+
+    EventSink eventSink;
+    LogosAPIClient* eventClient = nullptr;
+    bool isoTimestamps = false;
+
+    SlabPool<RequestContext> requestPool;
+    qint64 lastRequestId = 0;
+
+    // Requests made through the async API, resolved in deliverCallback
+    using Resolver = std::function<void(int callerRet, const QByteArray& payload)>;
+    QHash<qint64, Resolver> awaitedRequests;
+
+    std::vector<std::unique_ptr<BoundedMpscQueue<PendingCallback>>> callbackShards;
+    std::atomic<bool> drainScheduled{false};
+    std::atomic<quint64> enqueuedCallbacks{0};
+    std::atomic<quint64> droppedEvents{0};
+    std::atomic<quint64> overflowedCallbacks{0};
+
+    bool eventBatchingEnabled = false;
+    int eventBatchMaxSize = 256;
+    QVariantList eventBatch;
+    QTimer eventBatchTimer;
+
+    QSet<QString> structuredEvents;
+    int sharedMemoryThreshold = 0;
+    SharedPayloadPool sharedPayloads;
+    int compressionThreshold = 0;
+    bool compressionPrimed = true;
+    PayloadCompressor payloadCompressor;
+    EventSubscriptions subscriptions;
+
+    std::array<OperationMetrics, kCallbackKindCount> operationMetrics;
+    std::array<std::atomic<quint64>, 4> inboundEvents{};   // indexed by ChatEventType
+    std::array<quint64, 4> inboundEventsSnapshot{};
+    qint64 metricsSnapshotNs = 0;
+    QTimer metricsTimer;
+
+    int deliveryTimeoutMs = 30000;
+    LatencyHistogram deliveryLatency;
+    quint64 deliveriesTimedOut = 0;
+    QTimer deliveryTimer;
+
+    QTimer outboxSyncTimer;
+    quint64 outboxQueued = 0;
+    quint64 outboxDrained = 0;
+
+    int laneWindow = 0;                            // 0: calls are never held
+    std::array<int, LaneScheduler::kLaneCount> laneWeights{{8, 4, 1}};
+    std::array<int, kCallbackKindCount> operationLanes{};
+    std::array<LaneMetrics, LaneScheduler::kLaneCount> laneMetrics;
+
+    int introBundlePoolSize = 0;
+    quint64 introBundleHits = 0;
+    quint64 introBundleMisses = 0;
+    quint64 introBundlesRefilled = 0;
+    quint64 introBundleRefillFailures = 0;
+
+    static void forward_callback(CallbackKind kind, int callerRet, const char* msg, size_t len, void* userData);
+    static void dispatch_callback(ChatContext* chat, CallbackKind kind, int callerRet, const char* msg, size_t len, void* context);
 
     static void init_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void start_callback(int callerRet, const char* msg, size_t len, void* userData);
@@ -357,9 +1504,14 @@ private:
     static void event_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void get_id_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void list_conversations_callback(int callerRet, const char* msg, size_t len, void* userData);
+    static void refresh_conversations_callback(int callerRet, const char* msg, size_t len, void* userData);
+    static void seed_conversations_callback(int callerRet, const char* msg, size_t len, void* userData);
+    static void stream_conversations_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void get_conversation_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void new_private_conversation_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void send_message_callback(int callerRet, const char* msg, size_t len, void* userData);
+    static void send_batch_item_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void get_identity_callback(int callerRet, const char* msg, size_t len, void* userData);
     static void create_intro_bundle_callback(int callerRet, const char* msg, size_t len, void* userData);
+    static void refill_intro_bundle_callback(int callerRet, const char* msg, size_t len, void* userData);
 };
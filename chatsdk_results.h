@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+
+/**
+ * @brief Outcome of an SDK operation awaited through the plugin's async API.
+ *
+ * Carries the same information as the operation's result event, without the
+ * @c QVariantList boxing.
+ */
+struct ChatSDKResult {
+    bool success = false;
+    int code = 0;                // SDK status code; -1 if the request was never submitted
+    QByteArray payload;          // SDK response as delivered (JSON, bundle string, or empty)
+    qint64 requestId = 0;        // 0 if the request was never submitted
+    qint64 contextHandle = 0;
+};
+
+/** @brief Outcome of an awaited send, with the message ID already extracted. */
+struct SendResult : ChatSDKResult {
+    QString convoId;
+    QString messageId;           // empty if the SDK returned none
+};
@@ -0,0 +1,292 @@
+#include "conversation_index.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Removal records kept for delta polling; pollers further behind get a full list
+constexpr int kMaxRemovals = 1024;
+
+// Fields the index adds to the SDK's conversation objects
+const char* const kIndexFields[] = { "lastMessageAt", "lastDeliveryAckAt" };
+
+}
+
+bool ConversationIndex::reset(const QByteArray& listJson)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(listJson);
+
+    QVariantList items;
+    if (doc.isArray()) {
+        items = doc.toVariant().toList();
+    } else if (doc.isObject() && doc.object().value("conversations").isArray()) {
+        items = doc.object().value("conversations").toVariant().toList();
+    } else {
+        return false;
+    }
+
+    beginSync();
+    insertItems(items);
+    endSync();
+    return true;
+}
+
+void ConversationIndex::beginSync()
+{
+    syncing = true;
+    synced.clear();
+}
+
+bool ConversationIndex::append(const QByteArray& arrayJson)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(arrayJson);
+    if (!doc.isArray()) {
+        return false;
+    }
+
+    insertItems(doc.toVariant().toList());
+    return true;
+}
+
+void ConversationIndex::endSync()
+{
+    if (!syncing) {
+        return;
+    }
+    syncing = false;
+
+    if (synced.size() == order.size()) {
+        synced.clear();
+        return;
+    }
+
+    QStringList kept;
+    kept.reserve(synced.size());
+    for (const QString& convoId : std::as_const(order)) {
+        if (synced.contains(convoId)) {
+            kept << convoId;
+        } else {
+            remove(convoId);
+        }
+    }
+    synced.clear();
+
+    order = kept;
+    positions.clear();
+    for (int i = 0; i < order.size(); ++i) {
+        positions.insert(order.at(i), i);
+    }
+    pruneRemovals();
+}
+
+QString ConversationIndex::upsert(const QByteArray& conversationJson)
+{
+    const QVariantMap object = QJsonDocument::fromJson(conversationJson).toVariant().toMap();
+    const QString convoId = conversationId(object);
+    if (convoId.isEmpty()) {
+        return QString();
+    }
+
+    // Push events wrap the conversation; store the conversation itself
+    QVariantMap entry = object.contains("conversation") ? object.value("conversation").toMap() : object;
+    entry.remove("eventType");
+    if (!entry.contains("id")) {
+        entry["id"] = convoId;
+    }
+
+    insert(convoId, entry);
+    return convoId;
+}
+
+void ConversationIndex::touch(const QString& convoId, qint64 timestampMs)
+{
+    if (convoId.isEmpty()) {
+        return;
+    }
+
+    auto it = entries.find(convoId);
+    if (it == entries.end()) {
+        insert(convoId, QVariantMap{ { "id", convoId }, { "lastMessageAt", timestampMs } });
+        return;
+    }
+    (*it)["lastMessageAt"] = timestampMs;
+    bump(convoId);
+}
+
+void ConversationIndex::acknowledge(const QString& convoId, qint64 timestampMs)
+{
+    auto it = entries.find(convoId);
+    if (it == entries.end()) {
+        return;
+    }
+    (*it)["lastDeliveryAckAt"] = timestampMs;
+    bump(convoId);
+}
+
+QVariantList ConversationIndex::list() const
+{
+    QVariantList result;
+    result.reserve(order.size());
+    for (const QString& convoId : order) {
+        result << entries.value(convoId);
+    }
+    return result;
+}
+
+QVariantList ConversationIndex::page(const QString& afterId, int limit, QString& nextId, bool& found) const
+{
+    nextId.clear();
+    found = true;
+
+    int begin = 0;
+    if (!afterId.isEmpty()) {
+        auto it = positions.constFind(afterId);
+        if (it == positions.constEnd()) {
+            found = false;
+            return QVariantList();
+        }
+        begin = it.value() + 1;
+    }
+
+    const int end = static_cast<int>(std::min<qint64>(order.size(), qint64(begin) + qMax(limit, 0)));
+    QVariantList result;
+    result.reserve(qMax(end - begin, 0));
+    for (int i = begin; i < end; ++i) {
+        result << entries.value(order.at(i));
+    }
+
+    if (end < order.size() && end > begin) {
+        nextId = order.at(end - 1);
+    }
+    return result;
+}
+
+QVariantList ConversationIndex::changedSince(quint64 sinceVersion, bool& full) const
+{
+    full = sinceVersion == 0 || sinceVersion < baseVersion;
+
+    QVariantList result;
+    for (auto it = full ? changes.constBegin() : changes.upperBound(sinceVersion); it != changes.constEnd(); ++it) {
+        auto entry = entries.constFind(it.value());
+        if (entry != entries.constEnd()) {
+            QVariantMap changed = *entry;
+            changed["version"] = it.key();
+            result << changed;
+        } else if (!full) {
+            result << QVariantMap{ { "id", it.value() }, { "version", it.key() }, { "removed", true } };
+        }
+    }
+    return result;
+}
+
+QString ConversationIndex::conversationId(const QVariantMap& object)
+{
+    static const char* const keys[] = { "conversationId", "convoId", "id" };
+
+    for (const char* key : keys) {
+        const QString value = object.value(key).toString();
+        if (!value.isEmpty()) {
+            return value;
+        }
+    }
+
+    const QVariantMap nested = object.value("conversation").toMap();
+    if (!nested.isEmpty()) {
+        return conversationId(nested);
+    }
+    return QString();
+}
+
+void ConversationIndex::insert(const QString& convoId, QVariantMap entry)
+{
+    if (syncing) {
+        synced.insert(convoId);
+    }
+
+    auto existing = entries.find(convoId);
+    if (existing == entries.end()) {
+        if (versions.contains(convoId)) {
+            --removedCount;
+        }
+        positions.insert(convoId, order.size());
+        order << convoId;
+        entries.insert(convoId, entry);
+        bump(convoId);
+        return;
+    }
+
+    // Keep plugin-maintained fields across updates
+    for (const char* field : kIndexFields) {
+        if (existing->contains(field) && !entry.contains(field)) {
+            entry[field] = existing->value(field);
+        }
+    }
+
+    // A list result repeats unchanged conversations; they keep their version
+    if (entry == *existing) {
+        return;
+    }
+    *existing = entry;
+    bump(convoId);
+}
+
+void ConversationIndex::remove(const QString& convoId)
+{
+    // The caller drops it from order
+    entries.remove(convoId);
+    bump(convoId);
+    ++removedCount;
+}
+
+void ConversationIndex::bump(const QString& convoId)
+{
+    auto it = versions.find(convoId);
+    if (it != versions.end()) {
+        changes.remove(it.value());
+        it.value() = ++currentVersion;
+    } else {
+        versions.insert(convoId, ++currentVersion);
+    }
+    changes.insert(currentVersion, convoId);
+}
+
+void ConversationIndex::pruneRemovals()
+{
+    // Oldest removals go first; pollers from before them need the full list
+    for (auto it = changes.begin(); removedCount > kMaxRemovals && it != changes.end();) {
+        if (entries.contains(it.value())) {
+            ++it;
+            continue;
+        }
+        baseVersion = it.key();
+        versions.remove(it.value());
+        it = changes.erase(it);
+        --removedCount;
+    }
+}
+
+void ConversationIndex::insertItems(const QVariantList& items)
+{
+    for (const QVariant& item : items) {
+        if (item.userType() == QMetaType::QVariantMap) {
+            const QVariantMap object = item.toMap();
+            const QString convoId = conversationId(object);
+            if (!convoId.isEmpty()) {
+                insert(convoId, object);
+            }
+        } else {
+            // A bare ID adds nothing to an entry that is already known
+            const QString convoId = item.toString();
+            if (convoId.isEmpty()) {
+                continue;
+            }
+            if (!entries.contains(convoId)) {
+                insert(convoId, QVariantMap{ { "id", convoId } });
+            } else if (syncing) {
+                synced.insert(convoId);
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+
+/**
+ * @class ConversationIndex
+ * @brief In-memory view of the client's conversations, keyed by conversation ID.
+ *
+ * Seeded from a @c chat_list_conversations result and kept current from
+ * push events, so conversation lookups can be answered without a round trip
+ * into liblogoschat. Entries are the conversation JSON objects as reported by
+ * the SDK; conversations only known from a message event hold just their ID
+ * until the next full refresh.
+ *
+ * Every change stamps the conversation with the next value of a version
+ * counter, and changes are kept ordered by version, so the conversations
+ * changed since a given version can be listed without walking the index.
+ * A list result is merged rather than swapped in: only conversations that
+ * are new or differ get a new version, and conversations missing from the
+ * list leave a removal record behind.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class ConversationIndex
+{
+public:
+    /**
+     * @brief Brings the index in line with a list-conversations result.
+     *
+     * Accepts a JSON array (of IDs or conversation objects) or an object
+     * holding such an array under @c "conversations". Same as
+     * @ref beginSync, @ref append and @ref endSync in one go.
+     *
+     * @return @c false if @p listJson has none of these shapes; the index is
+     *         left unchanged in that case.
+     */
+    bool reset(const QByteArray& listJson);
+
+    /**
+     * @brief Starts taking in a complete conversation list in parts.
+     *
+     * Conversations inserted from now until @ref endSync are the ones kept.
+     */
+    void beginSync();
+
+    /**
+     * @brief Adds the conversations of a JSON array without dropping existing ones.
+     *
+     * Used to build the index up chunk by chunk while a list is streamed.
+     *
+     * @return @c false if @p arrayJson is not a JSON array.
+     */
+    bool append(const QByteArray& arrayJson);
+
+    /** @brief Removes every conversation not inserted since @ref beginSync. */
+    void endSync();
+
+    /**
+     * @brief Inserts or updates a conversation from a JSON object.
+     *
+     * Accepts the conversation object itself or a push event that nests it
+     * under @c "conversation".
+     *
+     * @return The conversation ID, or an empty string if none was found.
+     */
+    QString upsert(const QByteArray& conversationJson);
+
+    /** @brief Records activity on @p convoId, creating a stub entry if needed. */
+    void touch(const QString& convoId, qint64 timestampMs);
+
+    /** @brief Records a delivery acknowledgement on @p convoId if it is indexed. */
+    void acknowledge(const QString& convoId, qint64 timestampMs);
+
+    /** @brief Returns the entry for @p convoId, or an empty map. */
+    QVariantMap get(const QString& convoId) const { return entries.value(convoId); }
+
+    /** @brief Returns every entry in the order conversations became known. */
+    QVariantList list() const;
+
+    /**
+     * @brief Returns up to @p limit entries following @p afterId, in @ref list order.
+     *
+     * @param afterId   Conversation to continue after; empty to start at the beginning.
+     * @param limit     Maximum number of entries to return.
+     * @param nextId    Receives the ID to pass as @p afterId for the next page,
+     *                  or an empty string if this page reaches the end.
+     * @param found     Set to @c false if @p afterId is not in the index.
+     */
+    QVariantList page(const QString& afterId, int limit, QString& nextId, bool& found) const;
+
+    int size() const { return entries.size(); }
+
+    /** @brief Version of the most recent change; never decreases. */
+    quint64 version() const { return currentVersion; }
+
+    /**
+     * @brief Returns the entries changed after @p sinceVersion, oldest change first.
+     *
+     * Each returned entry carries its last-modified version under
+     * @c "version". A conversation removed since is returned as just its
+     * @c "id", @c "version" and @c "removed" set to @c true.
+     *
+     * @param sinceVersion A value previously returned by @ref version, or 0.
+     * @param full         Set to @c true if removals after @p sinceVersion
+     *                     have since been forgotten; every entry is
+     *                     returned then, without removal records, and
+     *                     conversations missing from it are gone.
+     */
+    QVariantList changedSince(quint64 sinceVersion, bool& full) const;
+
+    /**
+     * @brief Extracts the conversation ID from a conversation object or push event.
+     *
+     * Looks for @c "conversationId", @c "convoId" and @c "id", at the top level
+     * and inside a nested @c "conversation" object.
+     */
+    static QString conversationId(const QVariantMap& object);
+
+private:
+    void insert(const QString& convoId, QVariantMap entry);
+    void insertItems(const QVariantList& items);
+    void remove(const QString& convoId);
+    void bump(const QString& convoId);
+    void pruneRemovals();
+
+    QHash<QString, QVariantMap> entries;
+    QStringList order;
+    QHash<QString, int> positions;   // index into order, for cursor lookups
+
+    quint64 currentVersion = 0;
+    quint64 baseVersion = 0;         // removals up to this version are forgotten
+    QHash<QString, quint64> versions;   // live and removed conversations
+    QMap<quint64, QString> changes;  // latest change of each conversation, by version
+    int removedCount = 0;            // entries of versions that are removal records
+
+    bool syncing = false;
+    QSet<QString> synced;            // inserted since beginSync
+};
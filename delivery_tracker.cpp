@@ -0,0 +1,76 @@
+#include "delivery_tracker.h"
+
+void DeliveryTracker::track(const QString& messageId, const QString& convoId, qint64 sentAtNs)
+{
+    if (messageId.isEmpty()) {
+        return;
+    }
+
+    // A repeated ID restarts tracking rather than counting the message twice
+    auto existing = messages.find(messageId);
+    if (existing != messages.end()) {
+        remove(existing);
+    }
+
+    Entry entry;
+    entry.convoId = convoId;
+    entry.bySendTime = bySendTime.emplace(sentAtNs, messageId);
+    messages.insert(messageId, entry);
+    ++pendingCounts[convoId];
+}
+
+qint64 DeliveryTracker::acknowledge(const QString& messageId, QString& convoId)
+{
+    auto it = messages.find(messageId);
+    if (it == messages.end()) {
+        return -1;
+    }
+
+    const qint64 sentAtNs = it->bySendTime->first;
+    convoId = it->convoId;
+    remove(it);
+    return sentAtNs;
+}
+
+std::vector<DeliveryTracker::Expired> DeliveryTracker::expire(qint64 sentBeforeNs)
+{
+    std::vector<Expired> expired;
+    while (!bySendTime.empty() && bySendTime.begin()->first < sentBeforeNs) {
+        auto it = messages.find(bySendTime.begin()->second);
+
+        Expired entry;
+        entry.messageId = it.key();
+        entry.convoId = it->convoId;
+        entry.sentAtNs = bySendTime.begin()->first;
+        expired.push_back(entry);
+
+        remove(it);
+    }
+    return expired;
+}
+
+void DeliveryTracker::clear()
+{
+    messages.clear();
+    bySendTime.clear();
+    pendingCounts.clear();
+}
+
+QVariantMap DeliveryTracker::pendingByConversation() const
+{
+    QVariantMap result;
+    for (auto it = pendingCounts.constBegin(); it != pendingCounts.constEnd(); ++it) {
+        result.insert(it.key(), it.value());
+    }
+    return result;
+}
+
+void DeliveryTracker::remove(QHash<QString, Entry>::iterator it)
+{
+    auto count = pendingCounts.find(it->convoId);
+    if (count != pendingCounts.end() && --count.value() <= 0) {
+        pendingCounts.erase(count);
+    }
+    bySendTime.erase(it->bySendTime);
+    messages.erase(it);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QtGlobal>
+#include <map>
+#include <vector>
+
+/**
+ * @class DeliveryTracker
+ * @brief Matches sent messages with their delivery acknowledgements.
+ *
+ * A message is tracked under the ID liblogoschat assigns in its send result,
+ * from the time the send was submitted until the matching delivery ack
+ * arrives or its deadline passes. Outstanding messages are also kept ordered
+ * by send time, so expiring them only visits the ones that are overdue.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class DeliveryTracker
+{
+public:
+    /** A message whose acknowledgement did not arrive in time. */
+    struct Expired {
+        QString messageId;
+        QString convoId;
+        qint64 sentAtNs = 0;
+    };
+
+    /** @brief Starts tracking @p messageId, sent to @p convoId at @p sentAtNs (steady clock). */
+    void track(const QString& messageId, const QString& convoId, qint64 sentAtNs);
+
+    /**
+     * @brief Stops tracking @p messageId because its acknowledgement arrived.
+     *
+     * @param convoId Receives the conversation the message was sent to.
+     * @return The message's send time, or @c -1 if it is not tracked.
+     */
+    qint64 acknowledge(const QString& messageId, QString& convoId);
+
+    /** @brief Stops tracking and returns every message sent before @p sentBeforeNs, oldest first. */
+    std::vector<Expired> expire(qint64 sentBeforeNs);
+
+    /** @brief Drops every tracked message. */
+    void clear();
+
+    /** @brief Number of messages awaiting acknowledgement. */
+    int pending() const { return messages.size(); }
+
+    /** @brief Messages awaiting acknowledgement, keyed by conversation ID. */
+    QVariantMap pendingByConversation() const;
+
+private:
+    using SendTimeIndex = std::multimap<qint64, QString>;
+
+    struct Entry {
+        QString convoId;
+        SendTimeIndex::iterator bySendTime;
+    };
+
+    void remove(QHash<QString, Entry>::iterator it);
+
+    QHash<QString, Entry> messages;
+    SendTimeIndex bySendTime;
+    QHash<QString, int> pendingCounts;
+};
@@ -0,0 +1,41 @@
+#include "event_classifier.h"
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+
+ChatEventType eventTypeFromName(std::string_view name)
+{
+    if (name == "new_message") {
+        return ChatEventType::NewMessage;
+    } else if (name == "new_conversation") {
+        return ChatEventType::NewConversation;
+    } else if (name == "delivery_ack") {
+        return ChatEventType::DeliveryAck;
+    }
+    return ChatEventType::Unknown;
+}
+
+}
+
+ChatEventType classifyChatEvent(const char* data, size_t len)
+{
+    std::string_view eventType;
+    if (findJsonStringField(data, len, "eventType", eventType)) {
+        return eventTypeFromName(eventType);
+    }
+
+    if (!data || len == 0) {
+        return ChatEventType::Unknown;
+    }
+
+    // Unexpected shape (escaped value, non-string field, ...): parse properly
+    QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(data, static_cast<int>(len)));
+    if (!doc.isObject()) {
+        return ChatEventType::Unknown;
+    }
+
+    const QByteArray name = doc.object().value("eventType").toString().toUtf8();
+    return eventTypeFromName(std::string_view(name.constData(), static_cast<size_t>(name.size())));
+}
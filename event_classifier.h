@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+/** Push event types liblogoschat reports in the @c "eventType" field. */
+enum class ChatEventType {
+    Unknown,
+    NewMessage,
+    NewConversation,
+    DeliveryAck
+};
+
+/**
+ * @brief Locates a string-valued JSON field in a raw buffer without parsing it.
+ *
+ * Scans for @c "key" followed by a colon and a string value and returns a view
+ * of the value's raw bytes. The scan uses the library's vectorised
+ * @c memchr / @c memcmp, so its cost is a pass over the bytes rather than a
+ * DOM build.
+ *
+ * This is a fast path, not a parser. It only succeeds for the common shape
+ * (an unescaped key followed by a string value without escape sequences) and
+ * reports anything else as "not found" so the caller can fall back to a full
+ * parse. Occurrences of the key inside other strings are skipped because their
+ * quotes are escaped.
+ *
+ * @param data  JSON text.
+ * @param len   Length of @p data in bytes.
+ * @param key   Field name, without quotes.
+ * @param value Receives a view into @p data on success.
+ * @return @c true if the field was found in the expected shape.
+ */
+inline bool findJsonStringField(const char* data, size_t len, std::string_view key, std::string_view& value)
+{
+    if (!data || key.empty() || len < key.size() + 4) {
+        return false;
+    }
+
+    const std::string_view text(data, len);
+    size_t pos = 0;
+
+    for (;;) {
+        pos = text.find(key, pos);
+        if (pos == std::string_view::npos) {
+            return false;
+        }
+
+        const size_t keyEnd = pos + key.size();
+        const bool quoted = pos >= 1 && text[pos - 1] == '"'
+                            && keyEnd < len && text[keyEnd] == '"';
+        const bool escaped = pos >= 2 && text[pos - 2] == '\\';
+        if (!quoted || escaped) {
+            pos = keyEnd;
+            continue;
+        }
+
+        size_t i = keyEnd + 1;
+        while (i < len && (text[i] == ' ' || text[i] == '\t' || text[i] == '\n' || text[i] == '\r')) {
+            ++i;
+        }
+        if (i >= len || text[i] != ':') {
+            pos = keyEnd;
+            continue;
+        }
+        ++i;
+        while (i < len && (text[i] == ' ' || text[i] == '\t' || text[i] == '\n' || text[i] == '\r')) {
+            ++i;
+        }
+        if (i >= len || text[i] != '"') {
+            return false;
+        }
+
+        const size_t valueBegin = i + 1;
+        const void* close = std::memchr(data + valueBegin, '"', len - valueBegin);
+        if (!close) {
+            return false;
+        }
+
+        const size_t valueEnd = static_cast<const char*>(close) - data;
+        value = text.substr(valueBegin, valueEnd - valueBegin);
+
+        // Escape sequences need a real parser to decode
+        return value.find('\\') == std::string_view::npos;
+    }
+}
+
+/**
+ * @brief Reads the next element of a JSON array from a raw buffer without parsing it.
+ *
+ * Starting at @p pos, which must lie inside the array (just past its @c '['
+ * or a previous element), skips whitespace and the separating comma and
+ * returns a view of the element's raw bytes. Nesting and string escapes are
+ * tracked so commas and brackets inside the element do not end it; the
+ * element itself is not validated.
+ *
+ * @param data    JSON text.
+ * @param len     Length of @p data in bytes.
+ * @param pos     Scan position; advanced past the element on success.
+ * @param element Receives a view into @p data on success.
+ * @return @c false at the closing @c ']', or if the buffer ends mid-element.
+ */
+inline bool nextJsonArrayElement(const char* data, size_t len, size_t& pos, std::string_view& element)
+{
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+
+    while (pos < len && (isSpace(data[pos]) || data[pos] == ',')) {
+        ++pos;
+    }
+    if (pos >= len || data[pos] == ']') {
+        return false;
+    }
+
+    const size_t begin = pos;
+    int depth = 0;
+    bool inString = false;
+    for (; pos < len; ++pos) {
+        const char c = data[pos];
+        if (inString) {
+            if (c == '\\') {
+                ++pos;
+            } else if (c == '"') {
+                inString = false;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                break;
+            }
+            --depth;
+        } else if (c == ',' && depth == 0) {
+            break;
+        }
+    }
+    if (inString || depth != 0) {
+        return false;
+    }
+
+    size_t end = pos > len ? len : pos;
+    while (end > begin && isSpace(data[end - 1])) {
+        --end;
+    }
+    element = std::string_view(data + begin, end - begin);
+    return true;
+}
+
+/**
+ * @brief Determines the type of a push event from its raw JSON payload.
+ *
+ * Reads the @c "eventType" field with @ref findJsonStringField and falls back
+ * to a full JSON parse only when the payload does not have the expected shape.
+ *
+ * @param data JSON payload as delivered to the event callback.
+ * @param len  Length of @p data in bytes.
+ * @return The event type, or @c ChatEventType::Unknown for unrecognised or
+ *         malformed payloads.
+ */
+ChatEventType classifyChatEvent(const char* data, size_t len);
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @class BoundedMpscQueue
+ * @brief Fixed-capacity lock-free queue with many producers and one consumer.
+ *
+ * Used to hand liblogoschat callbacks, which run on threads owned by the
+ * library, over to the plugin's Qt thread without taking a lock. Producers
+ * never block: @ref tryPush fails when the queue is full and the caller
+ * decides what to do with the item.
+ *
+ * The implementation is a bounded ring of sequenced slots (D. Vyukov's
+ * bounded queue); each slot's sequence number tells producers and the
+ * consumer whether it is free or holds a published value.
+ *
+ * @tparam T Element type; must be default-constructible and move-assignable.
+ */
+template <typename T>
+class BoundedMpscQueue
+{
+public:
+    /**
+     * @brief Creates a queue holding at least @p minCapacity elements.
+     *
+     * The capacity is rounded up to the next power of two.
+     */
+    explicit BoundedMpscQueue(size_t minCapacity)
+    {
+        size_t capacity = 2;
+        while (capacity < minCapacity) {
+            capacity <<= 1;
+        }
+
+        slots.reset(new Slot[capacity]);
+        mask = capacity - 1;
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    /**
+     * @brief Appends @p value; safe to call from any thread.
+     *
+     * @return @c false if the queue is full, in which case @p value is left untouched.
+     */
+    bool tryPush(T&& value)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & mask];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest element into @p out; consumer thread only.
+     *
+     * @return @c false if the queue is empty.
+     */
+    bool tryPop(T& out)
+    {
+        const size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Slot& slot = slots[pos & mask];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1) < 0) {
+            return false;
+        }
+
+        out = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(pos + mask + 1, std::memory_order_release);
+        dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** @brief Number of slots in the ring. */
+    size_t capacity() const { return mask + 1; }
+
+    /** @brief Approximate number of queued elements; exact when no push is in progress. */
+    size_t depth() const
+    {
+        const size_t tail = dequeuePos.load(std::memory_order_relaxed);
+        const size_t head = enqueuePos.load(std::memory_order_relaxed);
+        return head > tail ? head - tail : 0;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+};
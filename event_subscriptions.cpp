@@ -0,0 +1,135 @@
+#include "event_subscriptions.h"
+#include <QtCore/QHash>
+
+namespace {
+
+// Indexed by ChatSDKEvent. Built once so emitting an event never converts a literal.
+const QString kEventNames[] = {
+    QStringLiteral("chatsdkInitResult"),
+    QStringLiteral("chatsdkStartResult"),
+    QStringLiteral("chatsdkStopResult"),
+    QStringLiteral("chatsdkDestroyResult"),
+    QStringLiteral("chatsdkBootResult"),
+    QStringLiteral("chatsdkGetIdResult"),
+    QStringLiteral("chatsdkListConversationsResult"),
+    QStringLiteral("chatsdkGetConversationResult"),
+    QStringLiteral("chatsdkConversationsRefreshed"),
+    QStringLiteral("chatsdkConversationsChunk"),
+    QStringLiteral("chatsdkNewPrivateConversationResult"),
+    QStringLiteral("chatsdkSendMessageResult"),
+    QStringLiteral("chatsdkSendMessagesResult"),
+    QStringLiteral("chatsdkBroadcastMessageResult"),
+    QStringLiteral("chatsdkGetIdentityResult"),
+    QStringLiteral("chatsdkCreateIntroBundleResult"),
+    QStringLiteral("chatsdkEvent"),
+    QStringLiteral("chatsdkNewMessage"),
+    QStringLiteral("chatsdkNewConversation"),
+    QStringLiteral("chatsdkDeliveryAck"),
+    QStringLiteral("chatsdkEventBatch"),
+    QStringLiteral("chatsdkMetrics"),
+    QStringLiteral("chatsdkDeliveryTimeout"),
+};
+
+static_assert(sizeof(kEventNames) / sizeof(kEventNames[0]) == static_cast<size_t>(ChatSDKEvent::Count),
+              "kEventNames must list every ChatSDKEvent");
+
+}
+
+const QString& chatSDKEventName(ChatSDKEvent event)
+{
+    return kEventNames[static_cast<int>(event)];
+}
+
+bool chatSDKEventCarriesJson(ChatSDKEvent event)
+{
+    // No default, so a new event has to be classified here
+    switch (event) {
+    case ChatSDKEvent::ListConversationsResult:
+    case ChatSDKEvent::GetConversationResult:
+    case ChatSDKEvent::ConversationsChunk:
+    case ChatSDKEvent::NewPrivateConversationResult:
+    case ChatSDKEvent::SendMessageResult:
+    case ChatSDKEvent::GetIdentityResult:
+    case ChatSDKEvent::Event:
+    case ChatSDKEvent::NewMessage:
+    case ChatSDKEvent::NewConversation:
+    case ChatSDKEvent::DeliveryAck:
+        return true;
+    case ChatSDKEvent::InitResult:
+    case ChatSDKEvent::StartResult:
+    case ChatSDKEvent::StopResult:
+    case ChatSDKEvent::DestroyResult:
+    case ChatSDKEvent::BootResult:
+    case ChatSDKEvent::GetIdResult:
+    case ChatSDKEvent::ConversationsRefreshed:
+    case ChatSDKEvent::SendMessagesResult:
+    case ChatSDKEvent::BroadcastMessageResult:
+    case ChatSDKEvent::CreateIntroBundleResult:
+    case ChatSDKEvent::EventBatch:
+    case ChatSDKEvent::Metrics:
+    case ChatSDKEvent::DeliveryTimeout:
+    case ChatSDKEvent::Count:
+        return false;
+    }
+    return false;
+}
+
+bool EventSubscriptions::subscribe(const QString& eventName)
+{
+    quint64 bits = 0;
+    if (!lookup(eventName, bits)) {
+        return false;
+    }
+
+    if (!explicitSubscriptions) {
+        explicitSubscriptions = true;
+        mask = 0;
+    }
+    mask |= bits;
+    return true;
+}
+
+bool EventSubscriptions::unsubscribe(const QString& eventName)
+{
+    quint64 bits = 0;
+    if (!lookup(eventName, bits)) {
+        return false;
+    }
+
+    explicitSubscriptions = true;
+    mask &= ~bits;
+    return true;
+}
+
+void EventSubscriptions::setConversationFilter(const QStringList& convoIds)
+{
+    conversations.clear();
+    for (const QString& convoId : convoIds) {
+        if (!convoId.isEmpty()) {
+            conversations.insert(convoId);
+        }
+    }
+}
+
+bool EventSubscriptions::lookup(const QString& eventName, quint64& bits)
+{
+    if (eventName == QLatin1String("*")) {
+        bits = kAllEvents;
+        return true;
+    }
+
+    static const QHash<QString, int> indexByName = []() {
+        QHash<QString, int> index;
+        for (int i = 0; i < static_cast<int>(ChatSDKEvent::Count); ++i) {
+            index.insert(kEventNames[i], i);
+        }
+        return index;
+    }();
+
+    auto it = indexByName.constFind(eventName);
+    if (it == indexByName.constEnd()) {
+        return false;
+    }
+    bits = quint64(1) << it.value();
+    return true;
+}
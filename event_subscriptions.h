@@ -0,0 +1,102 @@
+#pragma once
+
+#include "event_classifier.h"
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QtGlobal>
+
+/** Every event the plugin emits through @c eventResponse. */
+enum class ChatSDKEvent {
+    InitResult,
+    StartResult,
+    StopResult,
+    DestroyResult,
+    BootResult,
+    GetIdResult,
+    ListConversationsResult,
+    GetConversationResult,
+    ConversationsRefreshed,
+    ConversationsChunk,
+    NewPrivateConversationResult,
+    SendMessageResult,
+    SendMessagesResult,
+    BroadcastMessageResult,
+    GetIdentityResult,
+    CreateIntroBundleResult,
+    // Push events, in ChatEventType order
+    Event,
+    NewMessage,
+    NewConversation,
+    DeliveryAck,
+    EventBatch,
+    Metrics,
+    DeliveryTimeout,
+    Count
+};
+
+/** @brief Returns the wire name of @p event, e.g. @c "chatsdkNewMessage". */
+const QString& chatSDKEventName(ChatSDKEvent event);
+
+/** @brief Whether @p event carries an SDK JSON payload that can be delivered pre-parsed. */
+bool chatSDKEventCarriesJson(ChatSDKEvent event);
+
+/** @brief Returns the push event emitted for a classified SDK event. */
+inline ChatSDKEvent chatSDKPushEvent(ChatEventType type)
+{
+    return static_cast<ChatSDKEvent>(static_cast<int>(ChatSDKEvent::Event) + static_cast<int>(type));
+}
+
+/**
+ * @class EventSubscriptions
+ * @brief Decides which events are worth building and emitting.
+ *
+ * Events are tracked as bits of a single word, so @ref wants is one AND and
+ * can be checked before any event data is marshalled. Every event is
+ * delivered until the first @ref subscribe call; from then on only
+ * subscribed events are. Push events can additionally be limited to a set of
+ * conversations.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class EventSubscriptions
+{
+public:
+    /** @brief Whether @p event has a subscriber. */
+    bool wants(ChatSDKEvent event) const { return (mask & bit(event)) != 0; }
+
+    /** @brief Whether push events for @p convoId pass the conversation filter. */
+    bool wantsConversation(const QString& convoId) const
+    {
+        return conversations.isEmpty() || conversations.contains(convoId);
+    }
+
+    /**
+     * @brief Subscribes to @p eventName, or to every event for @c "*".
+     *
+     * The first call switches from "everything" to "only what is subscribed".
+     *
+     * @return @c false if @p eventName is not an event the plugin emits.
+     */
+    bool subscribe(const QString& eventName);
+
+    /**
+     * @brief Unsubscribes from @p eventName, or from every event for @c "*".
+     *
+     * @return @c false if @p eventName is not an event the plugin emits.
+     */
+    bool unsubscribe(const QString& eventName);
+
+    /** @brief Limits push events to @p convoIds; an empty list removes the filter. */
+    void setConversationFilter(const QStringList& convoIds);
+
+private:
+    static constexpr quint64 kAllEvents = (quint64(1) << static_cast<int>(ChatSDKEvent::Count)) - 1;
+
+    static quint64 bit(ChatSDKEvent event) { return quint64(1) << static_cast<int>(event); }
+    static bool lookup(const QString& eventName, quint64& bits);
+
+    quint64 mask = kAllEvents;
+    bool explicitSubscriptions = false;
+    QSet<QString> conversations;
+};
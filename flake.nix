@@ -57,6 +57,7 @@
           buildInputs = [
             pkgs.qt6.qtbase
             pkgs.qt6.qtremoteobjects
+            pkgs.zlib
           ];
           
           shellHook = ''
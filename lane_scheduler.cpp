@@ -0,0 +1,137 @@
+#include "lane_scheduler.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Strides are this divided by the weight, so every weight up to kMaxWeight
+// keeps a distinct stride
+constexpr quint64 kStrideScale = quint64(1) << 20;
+
+const char* const kLaneNames[LaneScheduler::kLaneCount] = { "control", "interactive", "bulk" };
+
+}
+
+LaneScheduler::LaneScheduler()
+{
+    setWeight(Control, 1);
+    setWeight(Interactive, 1);
+    setWeight(Bulk, 1);
+}
+
+const char* LaneScheduler::laneName(int lane)
+{
+    return lane >= 0 && lane < kLaneCount ? kLaneNames[lane] : "unknown";
+}
+
+int LaneScheduler::laneFromName(const QString& name)
+{
+    for (int lane = 0; lane < kLaneCount; ++lane) {
+        if (name == QLatin1String(kLaneNames[lane])) {
+            return lane;
+        }
+    }
+    return -1;
+}
+
+void LaneScheduler::setWeight(int lane, int weight)
+{
+    weight = std::clamp(weight, 1, kMaxWeight);
+    lanes[static_cast<size_t>(lane)].stride = kStrideScale / static_cast<quint64>(weight);
+}
+
+void LaneScheduler::push(int lane, Call call)
+{
+    Queue& queue = lanes[static_cast<size_t>(lane)];
+    if (queue.calls.empty()) {
+        queue.pass = std::max(queue.pass, virtualTime);
+    }
+    queue.calls.push_back(std::move(call));
+    ++queuedCount;
+}
+
+bool LaneScheduler::pop(Call& call, int& lane)
+{
+    // Earliest virtual finish wins; ties go to the higher-priority lane
+    int next = -1;
+    for (int i = 0; i < kLaneCount; ++i) {
+        const Queue& queue = lanes[static_cast<size_t>(i)];
+        if (!queue.calls.empty() && (next < 0 || queue.pass < lanes[static_cast<size_t>(next)].pass)) {
+            next = i;
+        }
+    }
+    if (next < 0) {
+        return false;
+    }
+
+    Queue& queue = lanes[static_cast<size_t>(next)];
+    virtualTime = queue.pass;
+    queue.pass += queue.stride;
+    call = std::move(queue.calls.front());
+    queue.calls.pop_front();
+    --queuedCount;
+    lane = next;
+    return true;
+}
+
+bool LaneScheduler::move(qint64 requestId, int lane)
+{
+    // A batch queues one call per entry under the same request ID
+    std::vector<Call> moved;
+    for (int i = 0; i < kLaneCount; ++i) {
+        if (i == lane) {
+            continue;
+        }
+        std::deque<Call>& calls = lanes[static_cast<size_t>(i)].calls;
+        for (auto it = calls.begin(); it != calls.end();) {
+            if (it->requestId == requestId) {
+                moved.push_back(std::move(*it));
+                it = calls.erase(it);
+                --queuedCount;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (Call& call : moved) {
+        push(lane, std::move(call));
+    }
+    if (!moved.empty()) {
+        return true;
+    }
+
+    const std::deque<Call>& target = lanes[static_cast<size_t>(lane)].calls;
+    return std::any_of(target.begin(), target.end(), [requestId](const Call& call) { return call.requestId == requestId; });
+}
+
+std::vector<LaneScheduler::Call> LaneScheduler::takeAll()
+{
+    std::vector<Call> calls;
+    calls.reserve(static_cast<size_t>(queuedCount));
+    for (Queue& queue : lanes) {
+        for (Call& call : queue.calls) {
+            calls.push_back(std::move(call));
+        }
+        queue.calls.clear();
+    }
+    queuedCount = 0;
+    return calls;
+}
+
+void LaneScheduler::started(int lane)
+{
+    ++lanes[static_cast<size_t>(lane)].inFlight;
+    ++inFlightCount;
+}
+
+void LaneScheduler::finished(int lane)
+{
+    // A mismatch with started() would leak a slot and shrink the window for good
+    Queue& queue = lanes[static_cast<size_t>(lane)];
+    Q_ASSERT_X(queue.inFlight > 0, "LaneScheduler::finished", "no call in flight in this lane");
+    if (queue.inFlight > 0) {
+        --queue.inFlight;
+        --inFlightCount;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+#include <array>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @class LaneScheduler
+ * @brief Weighted fair queue of SDK calls waiting for an in-flight slot, one FIFO per priority lane.
+ *
+ * liblogoschat works through submitted calls in order, so a call made behind
+ * thousands of sends waits for all of them. The plugin therefore keeps only
+ * a bounded window of calls outstanding per chat context and parks the rest
+ * here. As slots free up, @ref pop serves the lanes in proportion to their
+ * weights (stride scheduling over unit-cost calls), so a backlog in one
+ * lane delays the others by a few slots rather than by its length. A lane
+ * that was empty rejoins at the current virtual time and cannot bank credit
+ * while idle.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class LaneScheduler
+{
+public:
+    enum Lane {
+        Control,        // lifecycle: start, stop
+        Interactive,    // a user is waiting on the result
+        Bulk            // floods, syncs and background refills
+    };
+    static constexpr int kLaneCount = 3;
+    static constexpr int kMaxWeight = 1000;
+
+    /** A call waiting for a slot. */
+    struct Call {
+        qint64 requestId = 0;
+        qint64 queuedAtNs = 0;               // steady clock
+        std::function<int(int)> submit;      // issues the SDK call in the given lane and returns its status
+        std::function<void(int)> reject;     // fails the call with a status instead of issuing it
+    };
+
+    LaneScheduler();
+
+    static const char* laneName(int lane);
+
+    /** @return The lane called @p name, or @c -1 if there is none. */
+    static int laneFromName(const QString& name);
+
+    /** @brief Sets the share of slots @p lane gets while others are backlogged (1 to @ref kMaxWeight). */
+    void setWeight(int lane, int weight);
+
+    /** @brief Whether a new call may be issued right away instead of being queued. */
+    bool admits(int window) const
+    {
+        return queuedCount == 0 && (window == 0 || inFlightCount < window);
+    }
+
+    /** @brief Whether a slot is free for the next queued call. */
+    bool hasSlot(int window) const { return window == 0 || inFlightCount < window; }
+
+    /** @brief Queues @p call at the back of @p lane. */
+    void push(int lane, Call call);
+
+    /**
+     * @brief Takes the next call in weighted fair order.
+     *
+     * @return @c false if every lane is empty.
+     */
+    bool pop(Call& call, int& lane);
+
+    /**
+     * @brief Moves the queued calls of @p requestId to the back of @p lane.
+     *
+     * The calls are then issued in, and hold a slot of, @p lane; whoever
+     * frees the slot must use the lane passed to @ref Call::submit.
+     *
+     * @return @c false if none of its calls are queued.
+     */
+    bool move(qint64 requestId, int lane);
+
+    /** @brief Empties every lane and returns the calls in lane order. */
+    std::vector<Call> takeAll();
+
+    /** @brief Counts a call issued in @p lane against the window. */
+    void started(int lane);
+
+    /** @brief Frees the slot of a call issued in @p lane. */
+    void finished(int lane);
+
+    int depth(int lane) const { return static_cast<int>(lanes[static_cast<size_t>(lane)].calls.size()); }
+    int queued() const { return queuedCount; }
+    int inFlight() const { return inFlightCount; }
+    int inFlight(int lane) const { return lanes[static_cast<size_t>(lane)].inFlight; }
+
+private:
+    struct Queue {
+        std::deque<Call> calls;
+        quint64 stride = 0;
+        quint64 pass = 0;                    // virtual time at which the head is served
+        int inFlight = 0;
+    };
+
+    std::array<Queue, kLaneCount> lanes;
+    quint64 virtualTime = 0;
+    int queuedCount = 0;
+    int inFlightCount = 0;
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class LatencyHistogram
+ * @brief Lock-free log-linear histogram for nanosecond latencies.
+ *
+ * Values are bucketed HDR-style: each power of two is split into 16 linear
+ * sub-buckets, which bounds the relative error of any reported quantile to
+ * about 6% across the whole 64-bit range with a fixed footprint of 976
+ * buckets (61 exponent ranges of 16 sub-buckets).
+ *
+ * @ref record is a single relaxed atomic increment (plus a sum update and a
+ * rarely contended max), so it is cheap enough for liblogoschat callback
+ * threads. Readers may run concurrently with writers and see a consistent
+ * enough snapshot for monitoring purposes.
+ */
+class LatencyHistogram
+{
+public:
+    /** @brief Records one observation of @p valueNs nanoseconds. */
+    void record(uint64_t valueNs)
+    {
+        buckets[bucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(valueNs, std::memory_order_relaxed);
+
+        uint64_t seen = maximum.load(std::memory_order_relaxed);
+        while (valueNs > seen && !maximum.compare_exchange_weak(seen, valueNs, std::memory_order_relaxed)) {
+        }
+    }
+
+    /** @brief Number of recorded observations. */
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+    /** @brief Largest recorded value, in nanoseconds. */
+    uint64_t max() const { return maximum.load(std::memory_order_relaxed); }
+
+    /** @brief Mean of the recorded values, in nanoseconds. */
+    double mean() const
+    {
+        const uint64_t n = count();
+        return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    /**
+     * @brief Returns the value at quantile @p q (0..1), in nanoseconds.
+     *
+     * Reports the upper bound of the bucket holding the quantile, capped at
+     * the recorded maximum. Returns 0 when nothing has been recorded.
+     */
+    uint64_t valueAtQuantile(double q) const
+    {
+        const uint64_t n = count();
+        if (n == 0) {
+            return 0;
+        }
+
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(n) + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        } else if (rank > n) {
+            rank = n;
+        }
+
+        uint64_t seen = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint64_t upper = bucketUpperBound(i);
+                const uint64_t largest = max();
+                return upper < largest ? upper : largest;
+            }
+        }
+        return max();
+    }
+
+private:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static int mostSignificantBit(uint64_t value)
+    {
+        int bit = 0;
+        for (int shift = 32; shift > 0; shift >>= 1) {
+            if (value >> shift) {
+                value >>= shift;
+                bit += shift;
+            }
+        }
+        return bit;
+    }
+
+    static int bucketIndex(uint64_t value)
+    {
+        if (value < kSubBuckets) {
+            return static_cast<int>(value);
+        }
+        const int msb = mostSignificantBit(value);
+        const int shift = msb - kSubBucketBits;
+        const int sub = static_cast<int>((value >> shift) & (kSubBuckets - 1));
+        return (shift + 1) * kSubBuckets + sub;
+    }
+
+    static uint64_t bucketUpperBound(int index)
+    {
+        if (index < kSubBuckets) {
+            return static_cast<uint64_t>(index);
+        }
+        const int shift = index / kSubBuckets - 1;
+        const uint64_t sub = static_cast<uint64_t>(index % kSubBuckets);
+        const uint64_t lower = (kSubBuckets + sub) << shift;
+        return lower + ((uint64_t(1) << shift) - 1);
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maximum{0};
+};
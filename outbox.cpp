@@ -0,0 +1,318 @@
+#include "outbox.h"
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <zlib.h>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char kMagic[8] = { 'C', 'S', 'D', 'K', 'O', 'B', 'X', '1' };
+
+constexpr qint64 kHeaderSize = sizeof(kMagic);
+constexpr qint64 kInitialSize = 1024 * 1024;
+
+// Each record: u32 length of the rest, u32 CRC-32 of the rest, then
+// u8 type, u64 key and a type-specific body. A zero length ends the log.
+constexpr qint64 kRecordPrefix = 8;
+constexpr qint64 kRecordFixed = 1 + 8;
+
+enum RecordType : quint8 {
+    MessageRecord = 1,
+    DoneRecord = 2
+};
+
+}
+
+Outbox::Outbox(const QString& path)
+    : filePath(path)
+    , file(path)
+{
+}
+
+Outbox::~Outbox()
+{
+    if (map) {
+        sync();
+        file.unmap(map);
+    }
+}
+
+bool Outbox::open()
+{
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "Outbox: Cannot open" << filePath << "-" << file.errorString();
+        return false;
+    }
+
+    const bool created = file.size() == 0;
+    if (!created && file.size() < kHeaderSize) {
+        qWarning() << "Outbox:" << filePath << "is not an outbox log";
+        return false;
+    }
+
+    if (!remap(created ? kInitialSize : file.size())) {
+        return false;
+    }
+
+    if (created) {
+        std::memcpy(map, kMagic, sizeof(kMagic));
+        dirty = true;
+    } else if (std::memcmp(map, kMagic, sizeof(kMagic)) != 0) {
+        qWarning() << "Outbox:" << filePath << "is not an outbox log";
+        file.unmap(map);
+        map = nullptr;
+        return false;
+    }
+
+    tail = kHeaderSize;
+    replay();
+    return true;
+}
+
+quint64 Outbox::append(const QByteArray& convoId, const QByteArray& contentHex, qint64 queuedAtMs, qint64 requestId)
+{
+    QByteArray body;
+    body.reserve(8 + 4 + convoId.size() + 4 + contentHex.size());
+
+    char word[8];
+    qToLittleEndian<qint64>(queuedAtMs, word);
+    body.append(word, 8);
+    qToLittleEndian<quint32>(static_cast<quint32>(convoId.size()), word);
+    body.append(word, 4);
+    body.append(convoId);
+    qToLittleEndian<quint32>(static_cast<quint32>(contentHex.size()), word);
+    body.append(word, 4);
+    body.append(contentHex);
+
+    // Keys only need to be unique; random ones stay unique across truncations
+    quint64 key = 0;
+    while (key == 0) {
+        key = QRandomGenerator::global()->generate64();
+    }
+
+    if (!writeRecord(MessageRecord, key, body)) {
+        return 0;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.convoId = convoId;
+    entry.contentHex = contentHex;
+    entry.queuedAtMs = queuedAtMs;
+    entry.requestId = requestId;
+    queued << entry;
+    return key;
+}
+
+Outbox::Entry* Outbox::next()
+{
+    for (Entry& entry : queued) {
+        if (!entry.inFlight) {
+            entry.inFlight = true;
+            ++inFlightCount;
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void Outbox::complete(quint64 key)
+{
+    for (int i = 0; i < queued.size(); ++i) {
+        if (queued[i].key != key) {
+            continue;
+        }
+        if (queued[i].inFlight) {
+            --inFlightCount;
+        }
+        queued.removeAt(i);
+
+        if (queued.isEmpty()) {
+            compact();
+        } else {
+            writeRecord(DoneRecord, key, QByteArray());
+        }
+        return;
+    }
+}
+
+void Outbox::retry(quint64 key)
+{
+    for (Entry& entry : queued) {
+        if (entry.key == key && entry.inFlight) {
+            entry.inFlight = false;
+            --inFlightCount;
+            return;
+        }
+    }
+}
+
+bool Outbox::sync()
+{
+    if (!dirty || !map) {
+        return true;
+    }
+
+#ifdef Q_OS_WIN
+    const bool ok = FlushViewOfFile(map, 0)
+        && FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(file.handle())));
+#else
+    // fsync as well, for the size change of a truncation
+    const bool ok = msync(map, static_cast<size_t>(tail), MS_SYNC) == 0 && fsync(file.handle()) == 0;
+#endif
+    if (!ok) {
+        qWarning() << "Outbox: Cannot sync" << filePath;
+        return false;
+    }
+
+    dirty = false;
+    ++syncs;
+    return true;
+}
+
+QVariantMap Outbox::stats() const
+{
+    QVariantMap result;
+    result["pending"] = pending();
+    result["inFlight"] = inFlightCount;
+    result["logBytes"] = tail;
+    result["fileBytes"] = mappedSize;
+    result["syncs"] = static_cast<qulonglong>(syncs);
+    return result;
+}
+
+bool Outbox::reserve(qint64 bytes)
+{
+    if (tail + bytes + kRecordPrefix <= mappedSize) {
+        return true;
+    }
+
+    qint64 size = mappedSize;
+    while (tail + bytes + kRecordPrefix > size) {
+        size *= 2;
+    }
+    return remap(size);
+}
+
+bool Outbox::remap(qint64 size)
+{
+    if (map) {
+        file.unmap(map);
+        map = nullptr;
+    }
+
+    // On a failed resize the file is mapped at its old size again
+    const bool resized = file.size() == size || file.resize(size);
+    if (!resized) {
+        qWarning() << "Outbox: Cannot resize" << filePath << "to" << size << "bytes -" << file.errorString();
+    }
+
+    const qint64 actual = file.size();
+    map = actual >= kHeaderSize ? file.map(0, actual) : nullptr;
+    mappedSize = map ? actual : 0;
+    if (!map) {
+        qWarning() << "Outbox: Cannot map" << filePath << "-" << file.errorString();
+    }
+    return resized && map;
+}
+
+bool Outbox::writeRecord(quint8 type, quint64 key, const QByteArray& body)
+{
+    const qint64 length = kRecordFixed + body.size();
+    if (!map || !reserve(kRecordPrefix + length) || tail + kRecordPrefix + length > mappedSize) {
+        qWarning() << "Outbox: Cannot append to" << filePath;
+        return false;
+    }
+
+    uchar* record = map + tail;
+    uchar* rest = record + kRecordPrefix;
+    rest[0] = type;
+    qToLittleEndian<quint64>(key, rest + 1);
+    std::memcpy(rest + kRecordFixed, body.constData(), static_cast<size_t>(body.size()));
+
+    // Length last, so a record is only visible to replay once it is complete in memory
+    qToLittleEndian<quint32>(static_cast<quint32>(crc32(0, rest, static_cast<uInt>(length))), record + 4);
+    qToLittleEndian<quint32>(static_cast<quint32>(length), record);
+
+    tail += kRecordPrefix + length;
+    dirty = true;
+    return true;
+}
+
+void Outbox::replay()
+{
+    qint64 pos = kHeaderSize;
+    while (pos + kRecordPrefix <= mappedSize) {
+        const qint64 length = qFromLittleEndian<quint32>(map + pos);
+        if (length == 0) {
+            break;
+        }
+
+        const uchar* rest = map + pos + kRecordPrefix;
+        const bool fits = length >= kRecordFixed && pos + kRecordPrefix + length <= mappedSize;
+        if (!fits || qFromLittleEndian<quint32>(map + pos + 4) != static_cast<quint32>(crc32(0, rest, static_cast<uInt>(length)))) {
+            // Torn by a crash; nothing after it can be trusted
+            qWarning() << "Outbox: Discarding damaged tail of" << filePath << "at offset" << pos;
+            std::memset(map + pos, 0, static_cast<size_t>(mappedSize - pos));
+            dirty = true;
+            break;
+        }
+
+        const quint8 type = rest[0];
+        const quint64 key = qFromLittleEndian<quint64>(rest + 1);
+        const uchar* body = rest + kRecordFixed;
+        const qint64 bodyLength = length - kRecordFixed;
+
+        if (type == MessageRecord && bodyLength >= 12) {
+            Entry entry;
+            entry.key = key;
+            entry.queuedAtMs = qFromLittleEndian<qint64>(body);
+            const qint64 convoLength = qFromLittleEndian<quint32>(body + 8);
+            if (12 + convoLength + 4 <= bodyLength) {
+                const qint64 contentLength = qFromLittleEndian<quint32>(body + 12 + convoLength);
+                if (12 + convoLength + 4 + contentLength <= bodyLength) {
+                    entry.convoId = QByteArray(reinterpret_cast<const char*>(body + 12), convoLength);
+                    entry.contentHex = QByteArray(reinterpret_cast<const char*>(body + 16 + convoLength), contentLength);
+                    queued << entry;
+                }
+            }
+        } else if (type == DoneRecord) {
+            for (int i = 0; i < queued.size(); ++i) {
+                if (queued[i].key == key) {
+                    queued.removeAt(i);
+                    break;
+                }
+            }
+        }
+
+        pos += kRecordPrefix + length;
+    }
+    tail = pos;
+
+    qDebug() << "Outbox: Replayed" << filePath << "-" << queued.size() << "messages pending";
+}
+
+void Outbox::compact()
+{
+    // Truncating rather than rewinding, so stale records past the new tail
+    // can never be replayed
+    if (map) {
+        file.unmap(map);
+        map = nullptr;
+    }
+    if (!file.resize(kHeaderSize) || !remap(kInitialSize)) {
+        qWarning() << "Outbox: Cannot truncate" << filePath;
+        return;
+    }
+    tail = kHeaderSize;
+    dirty = true;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QtGlobal>
+
+/**
+ * @class Outbox
+ * @brief Durable queue of messages waiting to be sent, kept in a memory-mapped log.
+ *
+ * Messages are appended to the log as records and later marked done by a
+ * second record carrying the same idempotency key; opening an existing log
+ * replays it and restores every message that was never marked done, in
+ * order. Records are checksummed, so a write torn by a crash ends the replay
+ * instead of producing a bogus message. The file grows by doubling and is
+ * truncated back once every message is done.
+ *
+ * Writes land in the mapping and only reach the disk on @ref sync, so the
+ * caller decides how many appends share one flush. A message whose send
+ * succeeded but whose done record was not yet synced is sent again after a
+ * crash under the same key, which the plugin reports with the send result
+ * so callers can tell the repeat from a new message.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class Outbox
+{
+public:
+    /** A message not yet marked done. */
+    struct Entry {
+        quint64 key = 0;             // idempotency key, unique per message
+        QByteArray convoId;
+        QByteArray contentHex;
+        qint64 queuedAtMs = 0;
+        qint64 requestId = 0;        // reserved when queued; 0 for replayed messages
+        bool inFlight = false;
+    };
+
+    explicit Outbox(const QString& path);
+    ~Outbox();
+    Outbox(const Outbox&) = delete;
+    Outbox& operator=(const Outbox&) = delete;
+
+    /**
+     * @brief Opens or creates the log and replays it.
+     *
+     * @return @c false if the file could not be opened, sized or mapped.
+     */
+    bool open();
+
+    /**
+     * @brief Appends a message to the log.
+     *
+     * @return The message's idempotency key; @c 0 if the log could not grow.
+     */
+    quint64 append(const QByteArray& convoId, const QByteArray& contentHex, qint64 queuedAtMs, qint64 requestId);
+
+    /** @brief Oldest message that is not in flight, or @c nullptr. */
+    Entry* next();
+
+    /** @brief Marks the message with @p key done; it is not sent again. */
+    void complete(quint64 key);
+
+    /** @brief Returns an in-flight message to the queue. */
+    void retry(quint64 key);
+
+    /**
+     * @brief Flushes appended records to disk if any are unsynced.
+     *
+     * @return @c false if the flush failed.
+     */
+    bool sync();
+
+    const QString& path() const { return filePath; }
+    const QList<Entry>& entries() const { return queued; }
+    int pending() const { return queued.size(); }
+    int inFlight() const { return inFlightCount; }
+
+    /** @brief File size, log size and sync counters, for diagnostics. */
+    QVariantMap stats() const;
+
+private:
+    bool reserve(qint64 bytes);
+    bool remap(qint64 size);
+    bool writeRecord(quint8 type, quint64 key, const QByteArray& body);
+    void replay();
+    void compact();
+
+    QString filePath;
+    QFile file;
+    uchar* map = nullptr;
+    qint64 mappedSize = 0;
+    qint64 tail = 0;                 // offset of the next record
+    bool dirty = false;
+    QList<Entry> queued;
+    int inFlightCount = 0;
+    quint64 syncs = 0;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QVariant>
+#include <QtCore/QtGlobal>
+#include <memory>
+
+struct z_stream_s;
+
+/**
+ * @class PayloadCompressor
+ * @brief zlib compression of event payloads for consumers on a slow IPC link.
+ *
+ * Output uses the layout of @c qCompress: a four-byte big-endian
+ * uncompressed length followed by a zlib stream, so payloads compressed
+ * without the dictionary decode with @c qUncompress. Payloads compressed
+ * with the primed @ref dictionary carry its Adler-32 in the stream header
+ * (@c FDICT); consumers pass the same bytes to @c inflateSetDictionary when
+ * @c inflate asks for it, as @ref decompress does.
+ *
+ * The deflate state is allocated once per mode and reset between payloads,
+ * so steady-state compression performs no allocation beyond the output.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class PayloadCompressor
+{
+public:
+    PayloadCompressor();
+    ~PayloadCompressor();
+    PayloadCompressor(const PayloadCompressor&) = delete;
+    PayloadCompressor& operator=(const PayloadCompressor&) = delete;
+
+    /**
+     * @brief Preset dictionary built from the shape of typical event JSON.
+     *
+     * Gives short payloads, which have no history of their own to match
+     * against, back-references to field names and event types.
+     */
+    static const QByteArray& dictionary();
+
+    /**
+     * @brief Compresses @p len bytes from @p data into @p out.
+     *
+     * @param primed Whether to prime the stream with @ref dictionary.
+     * @return @c false if the result would not be smaller than the input (or
+     *         zlib failed); @p out is unspecified then and the caller sends
+     *         the payload as is.
+     */
+    bool compress(const char* data, qint64 len, bool primed, QByteArray& out);
+
+    /**
+     * @brief Reverses @ref compress, with or without the dictionary.
+     *
+     * @return @c false if @p compressed is not a complete stream of the
+     *         length its header declares.
+     */
+    static bool decompress(const QByteArray& compressed, QByteArray& out);
+
+    /** @brief Payload and byte counters, for diagnostics. */
+    QVariantMap stats() const;
+
+private:
+    z_stream_s* stream(bool primed);
+
+    std::unique_ptr<z_stream_s> plainStream;
+    std::unique_ptr<z_stream_s> primedStream;
+    quint64 compressed = 0;
+    quint64 skipped = 0;
+    quint64 bytesIn = 0;
+    quint64 bytesOut = 0;
+};
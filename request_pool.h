@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class SlabPool
+ * @brief Recycling allocator for fixed-size per-request objects.
+ *
+ * Objects are carved out of slabs of @p SlabSize elements and returned to a
+ * free list on @ref release, so steady-state request traffic performs no heap
+ * allocation. Slabs are only freed when the pool is destroyed.
+ *
+ * Not thread-safe; the plugin acquires and releases from its own thread.
+ *
+ * @tparam T        Element type; must be default-constructible and copy-assignable.
+ * @tparam SlabSize Number of elements allocated at a time.
+ */
+template <typename T, size_t SlabSize = 256>
+class SlabPool
+{
+public:
+    SlabPool() = default;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    /** @brief Returns a default-initialised object, growing the pool if needed. */
+    T* acquire()
+    {
+        if (freeList.empty()) {
+            slabs.emplace_back(new T[SlabSize]);
+            T* slab = slabs.back().get();
+            freeList.reserve(freeList.size() + SlabSize);
+            for (size_t i = SlabSize; i > 0; --i) {
+                freeList.push_back(&slab[i - 1]);
+            }
+        }
+
+        T* item = freeList.back();
+        freeList.pop_back();
+        ++used;
+        return item;
+    }
+
+    /** @brief Resets @p item and makes it available to @ref acquire again. */
+    void release(T* item)
+    {
+        if (!item) {
+            return;
+        }
+        *item = T();
+        freeList.push_back(item);
+        --used;
+    }
+
+    /**
+     * @brief Gives up every slab without freeing it.
+     *
+     * For teardown while another thread may still read objects that were
+     * handed out; that memory is leaked on purpose.
+     */
+    void abandon()
+    {
+        for (std::unique_ptr<T[]>& slab : slabs) {
+            slab.release();
+        }
+        slabs.clear();
+        freeList.clear();
+        used = 0;
+    }
+
+    /** @brief Number of objects currently handed out. */
+    size_t inUse() const { return used; }
+
+    /** @brief Number of objects allocated across all slabs. */
+    size_t allocated() const { return slabs.size() * SlabSize; }
+
+private:
+    std::vector<std::unique_ptr<T[]>> slabs;
+    std::vector<T*> freeList;
+    size_t used = 0;
+};
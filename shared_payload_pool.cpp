@@ -0,0 +1,131 @@
+#include "shared_payload_pool.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+// Bounds the shared memory the plugin holds on behalf of slow consumers.
+constexpr size_t kMaxSegments = 32;
+
+// Smallest segment created, so small payloads above the threshold still
+// leave room for reuse by larger ones.
+constexpr qint64 kMinSegmentSize = 64 * 1024;
+
+// Largest payload placed in shared memory; bigger ones go inline.
+constexpr qint64 kMaxSegmentSize = qint64(1) << 30;
+
+qint64 segmentSizeFor(qint64 len)
+{
+    qint64 size = kMinSegmentSize;
+    while (size < len) {
+        size <<= 1;
+    }
+    return size;
+}
+
+}
+
+SharedPayloadPool::SharedPayloadPool()
+    : keyPrefix(QStringLiteral("chatsdk_module-%1-").arg(QCoreApplication::applicationPid()))
+{
+}
+
+bool SharedPayloadPool::store(const char* data, qint64 len, Handle& handle)
+{
+    Segment* segment = len > 0 && len <= kMaxSegmentSize ? acquire(len) : nullptr;
+    if (!segment) {
+        ++fallbacks;
+        return false;
+    }
+
+    QSharedMemory& memory = *segment->memory;
+    memory.lock();
+    std::memcpy(memory.data(), data, static_cast<size_t>(len));
+    memory.unlock();
+
+    segment->inUse = true;
+    segment->slot = ++lastSlot;
+    ++stored;
+
+    handle.key = memory.key();
+    handle.slot = segment->slot;
+    handle.length = len;
+    return true;
+}
+
+bool SharedPayloadPool::release(qint64 slot)
+{
+    for (Segment& segment : segments) {
+        if (segment.inUse && segment.slot == slot) {
+            segment.inUse = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SharedPayloadPool::clear()
+{
+    segments.clear();
+}
+
+QVariantMap SharedPayloadPool::stats() const
+{
+    int inUse = 0;
+    qint64 bytes = 0;
+    for (const Segment& segment : segments) {
+        inUse += segment.inUse ? 1 : 0;
+        bytes += segment.memory->size();
+    }
+
+    QVariantMap result;
+    result["segments"] = static_cast<int>(segments.size());
+    result["inUse"] = inUse;
+    result["bytes"] = bytes;
+    result["stored"] = static_cast<qulonglong>(stored);
+    result["fallbacks"] = static_cast<qulonglong>(fallbacks);
+    return result;
+}
+
+SharedPayloadPool::Segment* SharedPayloadPool::acquire(qint64 len)
+{
+    // Smallest free segment that fits
+    Segment* best = nullptr;
+    Segment* smallestFree = nullptr;
+    for (Segment& segment : segments) {
+        if (segment.inUse) {
+            continue;
+        }
+        const qint64 size = segment.memory->size();
+        if (size >= len && (!best || size < best->memory->size())) {
+            best = &segment;
+        }
+        if (!smallestFree || size < smallestFree->memory->size()) {
+            smallestFree = &segment;
+        }
+    }
+    if (best) {
+        return best;
+    }
+
+    // Grow the pool, or trade a free segment that is too small for a bigger one
+    const bool grow = segments.size() < kMaxSegments;
+    if (!grow && !smallestFree) {
+        return nullptr;
+    }
+
+    auto memory = std::make_unique<QSharedMemory>(keyPrefix + QString::number(++lastSegmentId));
+    if (!memory->create(static_cast<int>(segmentSizeFor(len)))) {
+        qWarning() << "SharedPayloadPool: Failed to create shared memory segment -" << memory->errorString();
+        return nullptr;
+    }
+
+    if (grow) {
+        segments.emplace_back();
+        segments.back().memory = std::move(memory);
+        return &segments.back();
+    }
+    smallestFree->memory = std::move(memory);
+    return smallestFree;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QtCore/QSharedMemory>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QtGlobal>
+#include <memory>
+#include <vector>
+
+/**
+ * @class SharedPayloadPool
+ * @brief Recycled shared memory segments for handing large payloads to consumers.
+ *
+ * Each stored payload occupies one segment, identified to the consumer by
+ * the segment's key and a slot number. The consumer attaches to the key,
+ * reads the bytes and releases the slot, after which the segment is reused
+ * for a later payload of the same or smaller size. Segment sizes are rounded
+ * up to a power of two so differently sized payloads can share them.
+ *
+ * The number of segments is bounded; when every segment is in use (for
+ * example because a consumer never releases its slots), @ref store fails and
+ * the caller falls back to sending the payload inline.
+ *
+ * Not thread-safe; owned and used by the plugin thread.
+ */
+class SharedPayloadPool
+{
+public:
+    /** Where a stored payload can be read from. */
+    struct Handle {
+        QString key;
+        qint64 slot = 0;
+        qint64 length = 0;
+    };
+
+    SharedPayloadPool();
+    SharedPayloadPool(const SharedPayloadPool&) = delete;
+    SharedPayloadPool& operator=(const SharedPayloadPool&) = delete;
+
+    /**
+     * @brief Copies @p len bytes from @p data into a free segment.
+     *
+     * @return @c false if no segment could be provided; nothing is stored then.
+     */
+    bool store(const char* data, qint64 len, Handle& handle);
+
+    /**
+     * @brief Makes the segment holding @p slot available again.
+     *
+     * @return @c false if @p slot is unknown or was already released.
+     */
+    bool release(qint64 slot);
+
+    /** @brief Frees every segment, including ones still in use. */
+    void clear();
+
+    /** @brief Segment count, bytes and usage counters, for diagnostics. */
+    QVariantMap stats() const;
+
+private:
+    struct Segment {
+        std::unique_ptr<QSharedMemory> memory;
+        qint64 slot = 0;        // slot of the payload currently held, if in use
+        bool inUse = false;
+    };
+
+    Segment* acquire(qint64 len);
+
+    std::vector<Segment> segments;
+    QString keyPrefix;
+    qint64 lastSegmentId = 0;
+    qint64 lastSlot = 0;
+    quint64 stored = 0;
+    quint64 fallbacks = 0;
+};